@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// System clock settings. clk_peri is run from clk_sys in every profile, so
+// the SPI block reaches clk_sys / 2 (the PL022's fastest divider) and both
+// scale together. Apply before any peripheral is set up: SPI dividers, PIO
+// clock dividers and the UART baud are all computed from the clocks when
+// they are initialized.
+enum ClockProfile {
+    CLOCK_PROFILE_125,  // SDK default, 1.10 V
+    CLOCK_PROFILE_133,  // Datasheet maximum, 1.10 V
+    CLOCK_PROFILE_200,  // Overclock, 1.15 V
+    CLOCK_PROFILE_250   // Overclock, 1.20 V
+};
+
+// Returns false (clocks unchanged) if the PLL can't make the frequency.
+// Runs before stdio is up, so it prints nothing itself.
+bool applyClockProfile(ClockProfile profile);
+
+// Print the clocks in use, or why the profile wasn't applied; call with
+// applyClockProfile's result once stdio is up
+void logClockProfile(ClockProfile profile, bool applied);
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace displays {
+
+// A batch of panel commands and pixel bursts, sent by
+// TransferQueue::submitList() as a single job. On the PIO bus the queue
+// compiles the list into DMA control blocks that a pair of chained channels
+// executes, so once submitted the whole list (window setup, DC changes,
+// pixel data) runs without the CPU. On the SPI bus the DMA interrupt walks
+// the list instead.
+// The list and every pixel buffer it points to must stay valid until the
+// job's callback runs (or the queue is idle).
+class DisplayList {
+public:
+    static constexpr size_t MAX_OPS = 64;
+    static constexpr size_t MAX_PARAMS = 8;
+    static constexpr size_t MAX_WORDS = 320;   // Compiled command packets
+    static constexpr size_t MAX_BLOCKS = MAX_OPS * 2 + 2;
+
+    DisplayList();
+
+    void clear();
+    bool empty() const { return _count == 0; }
+    size_t size() const { return _count; }
+
+    bool addCommand(uint8_t cmd, const uint8_t* params = nullptr, size_t len = 0);
+    bool addPixels(const uint16_t* pixels, size_t count);
+
+    // Window (CASET/RASET), RAMWR and the pixels of a rectangle read from a
+    // buffer with a row pitch of stride pixels. Rows are sent as one burst
+    // when stride equals the width, otherwise one burst per row.
+    bool addRect(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                 const uint16_t* pixels, size_t stride);
+
+private:
+    friend class TransferQueue;
+
+    struct Op {
+        const uint16_t* pixels;     // nullptr for a command
+        uint32_t count;
+        uint8_t cmd;
+        uint8_t param_len;
+        uint8_t params[MAX_PARAMS];
+    };
+
+    // Loaded by the control channel into the data channel's alias 1
+    // registers; the write to TRANS_COUNT_TRIG starts the transfer
+    struct ControlBlock {
+        uint32_t ctrl;
+        const volatile void* read_addr;
+        volatile void* write_addr;
+        uint32_t count;
+    };
+
+    Op _ops[MAX_OPS];
+    size_t _count;
+
+    // Filled in by TransferQueue when the list is submitted on the PIO bus
+    ControlBlock _blocks[MAX_BLOCKS];
+    uint32_t _words[MAX_WORDS];
+};
+
+} // namespace displays
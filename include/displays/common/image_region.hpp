@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace displays {
+
+// A w x h rectangle at (x, y) on screen whose RGB565 pixels are read from a
+// buffer with a row pitch of stride pixels, so a sub-rectangle of a larger
+// image (a changed band of the frame, an OSD box) is drawn in place without
+// copying it out first. Row r of the rectangle starts at pixels + r * stride.
+struct ImageRegion {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+    const uint16_t* pixels;
+    uint16_t stride;
+};
+
+} // namespace displays
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace displays {
+
+// Refresh scan of a panel as seen from its TE (tearing effect) output.
+// TE rises at the start of vertical blanking; the panel then reads gate
+// line L from (blank_lines + L) * lineNs() to (blank_lines + L + 1) * lineNs()
+// after the edge, and starts over one period later.
+struct ScanTiming {
+    uint32_t period_ns;     // TE to TE
+    uint16_t lines;         // Gate lines
+    uint16_t blank_lines;   // Vertical front + back porch
+
+    uint32_t lineNs() const { return period_ns / (lines + blank_lines); }
+};
+
+// Gate lines [first, last) sent as one transfer, starting start_ns after
+// the TE edge the plan was made for
+struct ScanBand {
+    uint16_t first;
+    uint16_t last;
+    int64_t start_ns;
+};
+
+// How a band's transfer moves over its gate lines
+enum BandOrder {
+    BAND_SEQUENTIAL,    // Line by line in scan order (rows along the scan)
+    BAND_BLOCK          // Every line until the end (strips across the scan,
+                        // or rows written against it)
+};
+
+// Split a write of gate lines [first, last) into at most max_bands bands
+// that go out back to back, each started once the panel has read all of
+// its lines that the transfer will touch first, so the write never
+// overtakes the read. write_line_ns is the bus time per gate line.
+// Returns false if some band can't be finished before the next refresh
+// reaches it: the write is then too slow for one refresh and will tear,
+// but the bands are still filled in with their earliest start.
+bool planScanBands(const ScanTiming& scan, uint16_t first, uint16_t last,
+                   uint32_t write_line_ns, BandOrder order,
+                   ScanBand* bands, size_t max_bands, size_t& count);
+
+} // namespace displays
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "hardware/spi.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
+#include "displays/common/display_list.hpp"
+
+namespace displays {
+
+// Called from the DMA interrupt once a data or pixel transfer no longer
+// needs its source buffer
+typedef void (*TransferCallback)(void* context);
+
+// Ordered queue of SPI panel transfers shared by the TFT HALs.
+// Commands (with a few inline parameter bytes) are sent from the queue as
+// they come up; data and pixel transfers run on DMA and the next entry is
+// started from the DMA interrupt, so submit calls return immediately.
+// The queue owns CS and DC while it is busy: CS stays asserted until the
+// queue drains, and DC only changes after the SPI has finished shifting.
+// Pixels are RGB565 in CPU byte order and are sent straight from the
+// caller's buffer: the SPI switches to 16-bit frames for the transfer, so
+// each halfword goes out high byte first with no copy or byte swap.
+// With usePioBus() the wire is driven by a PIO state machine instead
+// (pio/lcd_spi), which sets CS and DC itself from packet headers in the
+// FIFO, so consecutive jobs stream back to back without CPU pin toggling.
+// useParallelBus() runs the same packets out over an 8080 parallel bus
+// (pio/lcd_8080).
+// A DisplayList submitted on the PIO bus runs as a DMA control-block chain.
+// Buffers passed to submitData/submitPixels must stay valid until their
+// callback runs (or isIdle() returns true).
+class TransferQueue {
+public:
+    static constexpr size_t QUEUE_DEPTH = 16;
+    static constexpr size_t MAX_PARAMS = 16;  // Longest init table entry (gamma)
+    static constexpr size_t INLINE_FILL = 8;  // Fills this short skip the DMA
+
+    TransferQueue();
+    ~TransferQueue();
+
+    // use_dma false makes every submit call blocking
+    bool init(spi_inst_t* spi, uint8_t pin_cs, uint8_t pin_dc, bool use_dma);
+    void deinit();
+
+    // Move the bus from the SPI block to a PIO state machine running
+    // lcd_spi.pio, clocked at up to sys_clk / 2. Needs SCK on pin_cs + 1;
+    // returns false (bus stays on the SPI) otherwise or if no state machine
+    // or program space is free.
+    bool usePioBus(uint8_t pin_sck, uint8_t pin_mosi, uint32_t baud_hz);
+    bool isPioBus() const { return _pio != nullptr; }
+
+    // Drive an 8080 parallel panel interface from PIO instead: WR on
+    // pin_cs + 1, width (8 or 16) data pins from pin_d0, RD tied high.
+    // write_hz is the WR strobe rate, up to sys_clk / 2; the 8-bit bus
+    // takes 2.5 strobe periods per pixel, the 16-bit bus 1.5. Returns
+    // false if the pins or PIO resources don't allow it.
+    bool useParallelBus(uint8_t pin_wr, uint8_t pin_d0, uint8_t width, uint32_t write_hz);
+
+    bool submitCommand(uint8_t cmd, const uint8_t* params = nullptr, size_t len = 0);
+    bool submitData(const uint8_t* data, size_t len,
+                    TransferCallback done = nullptr, void* context = nullptr);
+    bool submitPixels(const uint16_t* pixels, size_t count,
+                      TransferCallback done = nullptr, void* context = nullptr);
+    // rows runs of width pixels, stride pixels apart, as one burst on the wire
+    bool submitPixelRows(const uint16_t* pixels, size_t width, size_t rows, size_t stride,
+                         TransferCallback done = nullptr, void* context = nullptr);
+    // count pixels of one colour, streamed by DMA from a single word held in
+    // the queue (read increment off), so there is no buffer to keep valid
+    bool submitFill(uint16_t color, size_t count,
+                    TransferCallback done = nullptr, void* context = nullptr);
+    // Fails if the list doesn't fit its compiled form (DisplayList::MAX_WORDS)
+    bool submitList(DisplayList& list,
+                    TransferCallback done = nullptr, void* context = nullptr);
+
+    // Blocking writes for the HALs: wait for the queue, then send
+    void writeBytes(const uint8_t* data, size_t len, bool dc);
+
+    // Blocking read over the SPI block (MISO wired): send cmd, then clock in
+    // len bytes with DC high at read_hz, as panels read slower than they
+    // write. False on the PIO buses, which only write.
+    bool readBytes(uint8_t cmd, uint8_t* data, size_t len, uint32_t read_hz);
+
+    // Change the SPI block's write clock between transfers; returns the rate
+    // the divider gives (0 on the PIO buses)
+    uint32_t setSpiBaud(uint32_t baud_hz);
+
+    bool isIdle() const { return !_busy; }
+    // Jobs that can be submitted without waiting for a slot; submit() spins
+    // when there are none, so interrupt handlers check this first
+    size_t freeSlots() const { return QUEUE_DEPTH - (_head - _tail); }
+    bool waitIdle(uint32_t timeout_ms = 1000);
+    void abort();
+
+    bool isDmaEnabled() const { return _dma_channel >= 0; }
+
+private:
+    enum JobType : uint8_t {
+        JOB_COMMAND,
+        JOB_DATA,
+        JOB_PIXELS,
+        JOB_FILL,
+        JOB_LIST
+    };
+
+    struct Job {
+        JobType type;
+        uint8_t cmd;
+        uint8_t param_len;
+        uint8_t params[MAX_PARAMS];
+        const void* data;
+        size_t len;
+        uint16_t rows;          // Pixel rows of len, stride apart
+        uint16_t stride;
+        uint16_t color;         // Fill colour, read in place by the DMA
+        TransferCallback done;
+        void* context;
+    };
+
+    spi_inst_t* _spi;
+    uint8_t _pin_cs;
+    uint8_t _pin_dc;
+    int _dma_channel;
+    int _ctrl_channel;          // Loads display list control blocks (PIO bus)
+    dma_channel_config _dma_config;
+    volatile void* _dma_dest;   // SPI DR or PIO TX FIFO
+    uint8_t _frame_bits;        // Current SPI frame size
+    bool _initialized;
+
+    // PIO bus, when in use
+    PIO _pio;
+    uint _pio_sm;
+    uint _pio_offset;
+    const pio_program_t* _pio_program;
+
+    Job _jobs[QUEUE_DEPTH];
+    volatile uint32_t _head;    // Next free slot (written by submit)
+    volatile uint32_t _tail;    // Job in progress (written by the IRQ)
+    volatile bool _busy;
+    size_t _list_pos;           // Next op of a display list walked by the IRQ
+    size_t _row_pos;            // Row of a pixel rows job in progress
+
+    int claimPio(const pio_program_t* program, PIO& pio);
+    void attachPio(PIO pio, uint sm, uint offset, const pio_program_t* program);
+    bool submit(const Job& job);
+    void runBlocking(const Job& job);
+    void advance();
+    void onDmaComplete();
+    void finishJob();
+    bool listChained() const { return _pio && _ctrl_channel >= 0; }
+    bool compileList(DisplayList& list);
+    bool stepList(const DisplayList& list);
+    void runCommand(const Job& job);
+
+    // Bus primitives, SPI or PIO
+    void select();
+    void release();
+    void sendBytes(const uint8_t* data, size_t len, bool dc);
+    void sendPixels(const uint16_t* pixels, size_t count);
+    void sendPixelRepeat(uint16_t color, size_t count);
+    void startDma(const void* src, size_t count, uint8_t bits, size_t packet_count,  // packet_count: PIO header, all rows
+                  bool read_increment = true);
+    void setDc(bool data);
+    void setFrameBits(uint8_t bits);
+    void waitSpiIdle();
+    void waitPioIdle();
+
+    friend void transfer_queue_dma_done(void* context);
+};
+
+} // namespace displays
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <cstdio>
+#include <iterator>
+#include "dcs_config.hpp"
+#include "dcs_hal.hpp"
+#include "dcs_gfx.hpp"
+#include "dcs_presenter.hpp"
+#include "dcs_frame_rate.hpp"
+
+namespace displays {
+namespace dcs {
+
+// MIPI DCS panel driver. Everything a controller does differently lives in
+// its Traits (see st7789/st7789.hpp for an example):
+//
+//   struct Traits {
+//       static constexpr const char* NAME;           // For log messages
+//       static constexpr uint16_t WIDTH, HEIGHT;     // Native size at ROTATION_0
+//       static constexpr bool RGB444;                // COLMOD 0x53 over SPI
+//       static constexpr Orientation ORIENTATIONS[4];  // MADCTL per rotation
+//       static constexpr uint16_t TE_BLANK_LINES;    // Vertical porch, for TE timing
+//       static constexpr FrameRateModel FRAME_RATE;  // osc_hz 0 if not modelled
+//       static void writeFrameRate(HAL&, const FrameRateSetting&);  // If modelled
+//       static constexpr InitCommand INIT[];         // Sent after reset
+//   };
+//
+// INIT is queued in bursts between entries with a delay_ms, which should be
+// the datasheet minimum; the HAL holds SLPOUT until 120 ms after reset.
+//
+// Bus, queue and drawing code is shared (HAL, Graphics), so every panel gets
+// the same DMA and streaming paths; the template only adds the table lookups.
+template <typename Traits>
+class Panel {
+private:
+    HAL _hal;                   // Hardware abstraction layer
+    Graphics _gfx;              // Graphics functionality
+    TePresenter _presenter;     // Tear-free frames, with a TE pin
+    bool _initialized;          // Initialization flag
+    uint16_t _native_width;     // Size at ROTATION_0
+    uint16_t _native_height;
+    uint16_t _blank_lines;      // Vertical porch, for TE timing
+    uint32_t _osc_hz;           // Oscillator estimate for refresh matching
+    FrameRateSetting _frame_rate;
+    bool _frame_rate_set;
+    bool _partial;              // PTLON, see setPartialArea
+
+    void initializeDisplay();
+    void applyRotation(Rotation rotation);
+
+public:
+    Panel() :
+        _gfx(_hal),
+        _presenter(_hal),
+        _initialized(false),
+        _native_width(Traits::WIDTH),
+        _native_height(Traits::HEIGHT),
+        _blank_lines(Traits::TE_BLANK_LINES),
+        _osc_hz(Traits::FRAME_RATE.osc_hz),
+        _frame_rate(),
+        _frame_rate_set(false),
+        _partial(false) {}
+
+    // Display initialization
+    bool begin(const Config& config = Config());
+    bool begin(spi_inst_t* spi, uint8_t cs_pin, uint8_t dc_pin,
+               uint8_t rst_pin, uint8_t bl_pin = 10,
+               uint16_t width = 0, uint16_t height = 0);
+
+    // Display control
+    void setRotation(Rotation rotation) { if (_initialized) applyRotation(rotation); }
+    Rotation getRotation() { return _hal.getConfig().rotation; }
+    void invertDisplay(bool invert) { _hal.writeCommand(invert ? DCS_INVON : DCS_INVOFF); }
+    void fillScreen(uint16_t color) { _gfx.fillScreen(color); }
+    void sleepDisplay(bool sleep);
+    void setPixelFormat(PixelFormat format) { _hal.setPixelFormat(format); }
+    PixelFormat getPixelFormat() const { return _hal.getPixelFormat(); }
+    void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                       PixelFormat format = PIXEL_FORMAT_RGB565) { _hal.setAddrWindow(x0, y0, x1, y1, format); }
+    uint16_t width() const { return _hal.getConfig().width; }
+    uint16_t height() const { return _hal.getConfig().height; }
+
+    // Partial mode (PTLAR + PTLON): only the gate lines under the rectangle
+    // are refreshed from RAM and the rest becomes non-display area, shown in
+    // the controller's non-display level whatever RAM holds there. With MV
+    // the gate lines run along x, so the area spans the whole height.
+    // Set it again after a rotation. Returns false if the rectangle is off screen.
+    bool setPartialArea(int16_t x, int16_t y, int16_t w, int16_t h);
+    void clearPartialArea();    // Back to normal mode (NORON)
+    bool isPartial() const { return _partial; }
+
+    // Screen clearing
+    void clearScreen(uint16_t color = BLACK) { _gfx.fillScreen(color); }
+
+    // DMA related functions
+    bool isDmaEnabled() const { return _hal.isDmaEnabled(); }
+    bool isDmaBusy() const { return _presenter.isBusy() || _hal.isDmaBusy(); }
+    bool waitForDmaComplete(uint32_t timeout_ms = 1000) {
+        return _presenter.wait(timeout_ms) && _hal.waitForDmaComplete(timeout_ms);
+    }
+
+    // Efficient drawing functions using DMA
+    bool drawImageDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) { return _gfx.drawImage(x, y, w, h, data); }
+    bool drawDisplayList(displays::DisplayList& list) { return _hal.submitList(list); }  // Raw panel coordinates
+    bool fillRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { return _gfx.fillRect(x, y, w, h, color); }
+
+    // drawImageDMA in step with the panel's refresh when config.pin_te is set:
+    // the frame goes out in bands that stay behind the scan (see TePresenter)
+    bool presentImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) {
+        return _presenter.presentImage(x, y, w, h, data) || _gfx.drawImage(x, y, w, h, data);
+    }
+    uint32_t refreshPeriodUs() const { return _presenter.periodUs(); }  // From TE, 0 if unknown
+
+    // Set the refresh rate registers closest to target_period_us (e.g. a
+    // measured Game Boy frame). Call again to trim: with a TE pin the panel's
+    // measured refresh corrects the oscillator estimate first. Returns the
+    // expected period, 0 if the controller's rate isn't modelled or the panel
+    // is in partial mode.
+    uint32_t matchRefreshPeriod(uint32_t target_period_us);
+
+    // Draw pre-packed RGB444 data (see pixel_pack.hpp), w * h must be even.
+    // Returns at once; data must stay valid until waitForDmaComplete().
+    bool drawImageRGB444(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* data) {
+        static_assert(Traits::RGB444, "This controller has no 12-bit SPI pixel format");
+        return _gfx.drawImageRGB444(x, y, w, h, data);
+    }
+
+    // Hardware control
+    void setBacklight(bool on) { _hal.setBacklight(on); }
+    void setBrightness(uint8_t brightness) { _hal.setBrightness(brightness); }
+    void reset() { if (_initialized) initializeDisplay(); }
+
+    // Access to other components
+    Graphics& graphics() { return _gfx; }
+    HAL& hal() { return _hal; }
+
+    // Convenient drawing functions (passed to graphics class)
+    void drawPixel(int16_t x, int16_t y, uint16_t color) { _gfx.drawPixel(x, y, color); }
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) { _gfx.drawLine(x0, y0, x1, y1, color); }
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { _gfx.drawRect(x, y, w, h, color); }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { _gfx.fillRect(x, y, w, h, color); }
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) { _gfx.drawCircle(x0, y0, r, color); }
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) { _gfx.fillCircle(x0, y0, r, color); }
+    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) { _gfx.drawTriangle(x0, y0, x1, y1, x2, y2, color); }
+    void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) { _gfx.drawChar(x, y, c, color, bg, size); }
+    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) { _gfx.drawString(x, y, str, color, bg, size); }
+    void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) { _gfx.drawImage(x, y, w, h, data); }
+    bool drawImageRegions(const displays::ImageRegion* regions, size_t count) { return _gfx.drawImageRegions(regions, count); }
+
+    // Static helper functions
+    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) { return Graphics::color565(r, g, b); }
+    static uint16_t correctColor(uint16_t color) { return color; }  // Corrections live in panels.txt
+};
+
+template <typename Traits>
+bool Panel<Traits>::begin(const Config& config) {
+    if (_initialized) {
+        return true;
+    }
+
+    // The config gives the size at its rotation; keep it for ROTATION_0
+    if (config.width > 0 && config.height > 0) {
+        bool swapped = config.rotation & 1;
+        _native_width = swapped ? config.height : config.width;
+        _native_height = swapped ? config.width : config.height;
+    }
+
+    if (!_hal.init(config)) {
+        printf("%s: HAL initialization failed\n", Traits::NAME);
+        return false;
+    }
+
+    initializeDisplay();
+    if (config.pin_te >= 0) {
+        _presenter.init(config.pin_te);
+    }
+
+    _initialized = true;
+    printf("%s: Display initialized (%dx%d)\n", Traits::NAME, width(), height());
+    return true;
+}
+
+template <typename Traits>
+bool Panel<Traits>::begin(spi_inst_t* spi, uint8_t cs_pin, uint8_t dc_pin,
+                          uint8_t rst_pin, uint8_t bl_pin,
+                          uint16_t width, uint16_t height) {
+    Config config;
+    config.spi_inst = spi;
+    config.pin_cs = cs_pin;
+    config.pin_dc = dc_pin;
+    config.pin_reset = rst_pin;
+    config.pin_bl = bl_pin;
+    config.width = width;
+    config.height = height;
+
+    return begin(config);
+}
+
+template <typename Traits>
+void Panel<Traits>::initializeDisplay() {
+    // The init table puts the refresh rate back to its default
+    _frame_rate_set = false;
+    _blank_lines = Traits::TE_BLANK_LINES;
+    _partial = false;
+
+    _hal.reset();
+    _hal.runInitTable(Traits::INIT, std::size(Traits::INIT));
+    if (_hal.getConfig().pin_te >= 0) {
+        uint8_t te_mode = 0;  // V-blank only
+        _hal.writeCommand(DCS_TEON, &te_mode, 1);
+    }
+    applyRotation(_hal.getConfig().rotation);
+    if (!_initialized) {
+        // Once per boot, while the backlight is still off
+        _hal.tuneSpiClock(Traits::NAME);
+    }
+    fillScreen(BLACK);
+    setBacklight(true);
+}
+
+template <typename Traits>
+void Panel<Traits>::applyRotation(Rotation rotation) {
+    const Orientation& orientation = Traits::ORIENTATIONS[rotation & 3];
+    bool swapped = rotation & 1;
+
+    _hal.writeCommand(DCS_MADCTL, &orientation.madctl, 1);
+    _presenter.setScan(Traits::HEIGHT, _blank_lines, orientation.madctl);
+    _hal.setGeometry(rotation,
+                     swapped ? _native_height : _native_width,
+                     swapped ? _native_width : _native_height,
+                     orientation.x_offset, orientation.y_offset);
+}
+
+template <typename Traits>
+bool Panel<Traits>::setPartialArea(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (!_initialized || w <= 0 || h <= 0 || x < 0 || y < 0 || x + w > width() || y + h > height()) {
+        return false;
+    }
+
+    // Gate lines covered, counted as TePresenter does
+    uint8_t madctl = Traits::ORIENTATIONS[getRotation() & 3].madctl;
+    bool scan_x = madctl & MADCTL_MV;
+    int ram0 = scan_x ? x + _hal.getXOffset() : y + _hal.getYOffset();
+    int ram1 = ram0 + (scan_x ? w : h);
+    if (ram1 > Traits::HEIGHT) {
+        return false;
+    }
+    uint16_t first = (madctl & MADCTL_MY) ? Traits::HEIGHT - ram1 : ram0;
+    uint16_t last = first + (ram1 - ram0) - 1;
+
+    uint8_t ptlar[4] = {(uint8_t)(first >> 8), (uint8_t)first, (uint8_t)(last >> 8), (uint8_t)last};
+    _hal.writeCommand(DCS_PTLAR, ptlar, 4);
+    if (!_partial) {
+        _hal.writeCommand(DCS_PTLON);
+        _partial = true;
+    }
+    printf("%s: partial mode, gate lines %u-%u\n", Traits::NAME, first, last);
+    return true;
+}
+
+template <typename Traits>
+void Panel<Traits>::clearPartialArea() {
+    if (_initialized && _partial) {
+        _hal.writeCommand(DCS_NORON);
+        _partial = false;
+    }
+}
+
+template <typename Traits>
+uint32_t Panel<Traits>::matchRefreshPeriod(uint32_t target_period_us) {
+    if constexpr (Traits::FRAME_RATE.osc_hz == 0) {
+        return 0;
+    } else {
+        // Partial mode runs from its own rate registers, which aren't modelled
+        if (!_initialized || _partial) {
+            return 0;
+        }
+        _presenter.wait();
+
+        // The oscillator is only nominal; TE shows what the current setting gives
+        uint32_t measured_us = _presenter.periodUs();
+        if (_frame_rate_set && measured_us > 0) {
+            _osc_hz = frameRateOscillator(Traits::FRAME_RATE, Traits::HEIGHT, _frame_rate, measured_us * 1000);
+        }
+
+        FrameRateSetting setting;
+        if (!pickFrameRate(Traits::FRAME_RATE, _osc_hz, Traits::HEIGHT, target_period_us * 1000, setting)) {
+            return 0;
+        }
+        if (!_frame_rate_set || setting != _frame_rate) {
+            Traits::writeFrameRate(_hal, setting);
+            _frame_rate = setting;
+            _frame_rate_set = true;
+            _blank_lines = setting.front_porch + setting.back_porch;
+            _presenter.setScan(Traits::HEIGHT, _blank_lines, Traits::ORIENTATIONS[getRotation() & 3].madctl);
+            printf("%s: refresh %lu us for a %lu us source (RTNA 0x%02X, porch %d+%d)\n", Traits::NAME,
+                   (unsigned long)(setting.period_ns / 1000), (unsigned long)target_period_us,
+                   setting.rtna, setting.front_porch, setting.back_porch);
+        }
+        return setting.period_ns / 1000;
+    }
+}
+
+template <typename Traits>
+void Panel<Traits>::sleepDisplay(bool sleep) {
+    _hal.writeCommand(sleep ? DCS_SLPIN : DCS_SLPOUT);
+    _hal.delay(120);
+}
+
+} // namespace dcs
+} // namespace displays
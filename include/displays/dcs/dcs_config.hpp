@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "hardware/spi.h"
+#include "hardware/dma.h"
+
+// Types shared by the MIPI DCS panels (ST7789, ILI9341, ILI9342, ST7796).
+// A panel namespace pulls these in with `using namespace displays::dcs`, so
+// st7789::Config, ili9341::ROTATION_270 etc. keep working.
+namespace displays {
+namespace dcs {
+
+// Color definitions (RGB565 format)
+enum Color {
+    BLACK     = 0x0000,
+    WHITE     = 0xFFFF,
+    RED       = 0xF800,
+    GREEN     = 0x07E0,
+    BLUE      = 0x001F,
+    YELLOW    = 0xFFE0,
+    CYAN      = 0x07FF,
+    MAGENTA   = 0xF81F
+};
+
+// Rotation direction
+enum Rotation {
+    ROTATION_0   = 0,
+    ROTATION_90  = 1,
+    ROTATION_180 = 2,
+    ROTATION_270 = 3
+};
+
+// Interface pixel format (COLMOD parameter)
+enum PixelFormat {
+    PIXEL_FORMAT_RGB565 = 0x55,  // 16 bits/pixel
+    PIXEL_FORMAT_RGB444 = 0x53   // 12 bits/pixel, two pixels per three bytes
+};
+
+// Commands every DCS controller understands
+enum DcsCommand {
+    DCS_NOP     = 0x00,
+    DCS_SWRESET = 0x01,
+    DCS_SLPIN   = 0x10,
+    DCS_SLPOUT  = 0x11,
+    DCS_PTLON   = 0x12,
+    DCS_NORON   = 0x13,
+    DCS_INVOFF  = 0x20,
+    DCS_INVON   = 0x21,
+    DCS_DISPOFF = 0x28,
+    DCS_DISPON  = 0x29,
+    DCS_CASET   = 0x2A,
+    DCS_RASET   = 0x2B,
+    DCS_RAMWR   = 0x2C,
+    DCS_RAMRD   = 0x2E,
+    DCS_PTLAR   = 0x30,
+    DCS_TEOFF   = 0x34,
+    DCS_TEON    = 0x35,
+    DCS_MADCTL  = 0x36,
+    DCS_COLMOD  = 0x3A
+};
+
+// MADCTL parameter bits
+enum MadctlBits {
+    MADCTL_MY  = 0x80,  // Row address order
+    MADCTL_MX  = 0x40,  // Column address order
+    MADCTL_MV  = 0x20,  // Row/column exchange
+    MADCTL_ML  = 0x10,  // Vertical refresh order
+    MADCTL_RGB = 0x00,  // RGB order
+    MADCTL_BGR = 0x08,  // BGR order
+    MADCTL_MH  = 0x04   // Horizontal refresh order
+};
+
+// One entry of a panel's init table
+struct InitCommand {
+    uint8_t cmd;
+    uint8_t len;
+    uint8_t params[16];
+    uint16_t delay_ms;      // Wait after the command
+};
+
+// MADCTL value and RAM offset of the visible area for one rotation
+struct Orientation {
+    uint8_t madctl;
+    uint16_t x_offset;
+    uint16_t y_offset;
+};
+
+// DMA configuration
+struct DmaConfig {
+    bool enabled;           // Whether DMA is enabled
+    uint dma_tx_channel;    // DMA transmit channel
+
+    DmaConfig() :
+        enabled(true),
+        dma_tx_channel(0)   // Assigned during initialization
+    {}
+};
+
+// Configuration structure
+struct Config {
+    spi_inst_t* spi_inst;     // SPI instance
+    uint32_t spi_speed_hz;    // SPI speed
+    // Boot-time tuning (HAL::tuneSpiClock): with MISO wired, rates from
+    // spi_max_hz down to spi_speed_hz are written, read back and timed
+    uint32_t spi_max_hz;      // 0 to keep spi_speed_hz
+    int8_t pin_miso;          // Panel SDO, -1 if not wired
+    bool pio_bus;             // Drive the bus from PIO (needs SCK = CS + 1)
+
+    // 8080 parallel bus instead of SPI: 8 or 16 data pins from pin_d0,
+    // WR = CS + 1, RD tied high (see TransferQueue::useParallelBus)
+    uint8_t bus_width;        // 0 for SPI
+    uint8_t pin_wr;
+    uint8_t pin_d0;
+    uint32_t bus_write_hz;    // WR strobe rate
+
+    uint8_t pin_din;          // MOSI
+    uint8_t pin_sck;          // SCK
+    uint8_t pin_cs;           // Chip Select
+    uint8_t pin_dc;           // Data/Command
+    uint8_t pin_reset;        // Reset
+    uint8_t pin_bl;           // Backlight
+    int8_t pin_te;            // Tearing effect output, -1 if not wired
+
+    uint16_t width;           // Size at `rotation`, 0 for the panel's native size
+    uint16_t height;
+    Rotation rotation;        // Rotation direction
+
+    DmaConfig dma;
+
+    Config() :
+        spi_inst(spi1),
+        spi_speed_hz(40 * 1000 * 1000),  // 40MHz
+        spi_max_hz(0),
+        pin_miso(-1),
+        pio_bus(false),
+        bus_width(0),
+        pin_wr(10),
+        pin_d0(15),
+        bus_write_hz(15 * 1000 * 1000),  // 66 ns write cycle
+        pin_din(11),
+        pin_sck(14),
+        pin_cs(9),
+        pin_dc(12),
+        pin_reset(13),
+        pin_bl(8),
+        pin_te(-1),
+        width(0),
+        height(0),
+        rotation(ROTATION_0),
+        dma() {}
+};
+
+} // namespace dcs
+} // namespace displays
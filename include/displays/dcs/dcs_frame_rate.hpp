@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+namespace displays {
+namespace dcs {
+
+// How a controller derives its refresh rate:
+//   period = (clocks_base + clocks_step * rtna) * (gate lines + front + back porch) / osc_hz
+// osc_hz 0 means the controller has no model and its rate is left alone.
+struct FrameRateModel {
+    uint32_t osc_hz;        // Nominal internal oscillator
+    uint16_t clocks_base;   // Clocks per line
+    uint16_t clocks_step;
+    uint8_t rtna_min;       // Line period register range
+    uint8_t rtna_max;
+    uint8_t porch_min;      // Range of each vertical porch, in lines
+    uint8_t porch_max;
+};
+
+// Register values for one refresh rate, and the period they give
+struct FrameRateSetting {
+    uint8_t rtna;
+    uint8_t front_porch;
+    uint8_t back_porch;
+    uint32_t period_ns;
+
+    bool operator==(const FrameRateSetting& other) const {
+        return rtna == other.rtna && front_porch == other.front_porch && back_porch == other.back_porch;
+    }
+    bool operator!=(const FrameRateSetting& other) const { return !(*this == other); }
+};
+
+// Closest setting to target_period_ns for a controller running at osc_hz
+bool pickFrameRate(const FrameRateModel& model, uint32_t osc_hz, uint16_t lines,
+                   uint32_t target_period_ns, FrameRateSetting& setting);
+
+// Oscillator frequency implied by a measured refresh period with setting
+uint32_t frameRateOscillator(const FrameRateModel& model, uint16_t lines,
+                             const FrameRateSetting& setting, uint32_t measured_period_ns);
+
+} // namespace dcs
+} // namespace displays
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include "dcs_config.hpp"
+#include "dcs_hal.hpp"
+#include "displays/common/image_region.hpp"
+
+namespace displays {
+namespace dcs {
+
+// 5x7 font, five column bytes per character from ' ' to '~'
+extern const unsigned char font[];
+
+// Graphics class - handles drawing operations. Everything is clipped to the
+// screen and sent through the HAL's transfer queue.
+class Graphics {
+private:
+    HAL& _hal;
+
+    bool drawRegion(const displays::ImageRegion& region);
+
+public:
+    explicit Graphics(HAL& hal);
+
+    // Basic drawing functions
+    void drawPixel(int16_t x, int16_t y, uint16_t color);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    bool fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    void fillScreen(uint16_t color);
+
+    // Text functions
+    void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
+    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size);
+
+    // Image drawing. With DMA this returns at once and data must stay valid
+    // until the transfer completes (see HAL::isDmaBusy)
+    bool drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data);
+
+    // Several rectangles of strided source buffers, queued back to back as
+    // one CS-low burst. Each region is clipped on its own; returns false if
+    // any was invalid or entirely off screen (the others are still drawn).
+    // The same lifetime rule as drawImage applies to every source buffer.
+    bool drawImageRegions(const displays::ImageRegion* regions, size_t count);
+
+    // Pre-packed RGB444 data (see pixel_pack.hpp), w * h must be even.
+    // Switches the panel to 12-bit mode; RGB565 drawing switches it back.
+    // Queued like drawImage: data must stay valid until the DMA is done.
+    bool drawImageRGB444(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* data);
+
+    // Helper functions
+    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+};
+
+} // namespace dcs
+} // namespace displays
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include "hardware/spi.h"
+#include "hardware/dma.h"
+#include "pico/time.h"
+#include "dcs_config.hpp"
+#include "displays/common/transfer_queue.hpp"
+
+namespace displays {
+namespace dcs {
+
+// Hardware Abstraction Layer class - bus, pins and addressing shared by
+// every DCS panel. Nothing here depends on the controller.
+class HAL {
+private:
+    Config _config;             // width/height/rotation track setGeometry()
+    bool _initialized;
+    PixelFormat _pixel_format;  // Current COLMOD setting
+    uint16_t _x_offset;         // RAM offset of the visible area
+    uint16_t _y_offset;
+
+    // Transfer queue (DMA when enabled)
+    displays::TransferQueue _queue;
+    bool _dma_enabled;
+
+    absolute_time_t _reset_time;  // Last reset() release, for the SLPOUT deadline
+
+    bool verifyWrite();
+    uint32_t timeFrameUs();
+
+public:
+    HAL();
+    ~HAL();
+
+    // Initialize hardware
+    bool init(const Config& config);
+
+    // Basic IO operations (wait for queued transfers first)
+    void writeCommand(uint8_t cmd, const uint8_t* params = nullptr, size_t len = 0);
+    void writeDataBulk(const uint8_t* data, size_t len);
+    void runInitTable(const InitCommand* table, size_t count);
+
+    // Queued operations, return immediately
+    void queueCommand(uint8_t cmd, const uint8_t* params = nullptr, size_t len = 0);
+    bool writeDataDma(const uint16_t* data, size_t len);  // data must stay valid until !isDmaBusy()
+    bool writeBytesDma(const uint8_t* data, size_t len);  // 8-bit frames, same rule
+    bool fillPixels(uint16_t color, size_t count);         // One DMA transfer of a single colour
+    bool writePixelRows(const uint16_t* data, size_t width, size_t rows, size_t stride,
+                        displays::TransferCallback done = nullptr, void* context = nullptr);
+    bool isDmaBusy() const { return !_queue.isIdle(); }
+    size_t queueFreeSlots() const { return _queue.freeSlots(); }
+    bool submitList(displays::DisplayList& list) { return _queue.submitList(list); }  // list must stay valid until !isDmaBusy()
+    bool isDmaEnabled() const { return _dma_enabled; }
+    uint32_t pixelTimePs() const;  // Nominal bus time per RGB565 pixel
+
+    // Pick the fastest SPI clock up to spi_max_hz whose writes read back
+    // intact (RAMRD), timing a full-screen write at each, and keep it in
+    // flash for the next boot. Needs pin_miso and the SPI block; call with
+    // the backlight off, it draws on the panel. name keys the saved value.
+    // Returns the clock now in use.
+    uint32_t tuneSpiClock(const char* name);
+    bool waitForDmaComplete(uint32_t timeout_ms = 1000);
+    void abortDma();
+
+    // CASET/RASET/RAMWR in screen coordinates; switches COLMOD first if needed
+    void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                       PixelFormat format = PIXEL_FORMAT_RGB565);
+    void setPixelFormat(PixelFormat format);
+    PixelFormat getPixelFormat() const { return _pixel_format; }
+    uint16_t getXOffset() const { return _x_offset; }
+    uint16_t getYOffset() const { return _y_offset; }
+
+    // Hardware control
+    void reset();
+    void setBacklight(bool on);
+    void setBrightness(uint8_t brightness);
+    void delay(uint32_t ms);
+
+    // Get configuration
+    const Config& getConfig() const { return _config; }
+
+    // Screen size and RAM offsets after a rotation change
+    void setGeometry(Rotation rotation, uint16_t width, uint16_t height,
+                     uint16_t x_offset, uint16_t y_offset);
+};
+
+} // namespace dcs
+} // namespace displays
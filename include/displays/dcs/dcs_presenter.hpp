@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include "pico/time.h"
+#include "dcs_hal.hpp"
+#include "displays/common/scan_schedule.hpp"
+
+namespace displays {
+namespace dcs {
+
+// Tear-free frame presentation from the panel's TE (tearing effect) output.
+// A GPIO interrupt timestamps every TE edge; presentImage() splits the frame
+// into bands of gate lines (see scan_schedule.hpp) and a timer alarm queues
+// each band once the panel has read past it, so the write stays behind the
+// read and is done before the next refresh gets there.
+// Nothing else may be queued on the HAL while a frame is pending.
+class TePresenter {
+public:
+    static constexpr size_t MAX_BANDS = 8;
+
+    explicit TePresenter(HAL& hal);
+    ~TePresenter();
+
+    // Start timestamping TE edges on pin; the panel needs TEON
+    bool init(uint8_t pin_te);
+    bool isActive() const { return _pin_te >= 0; }
+
+    // Gate lines and vertical porch of the controller, and the MADCTL that
+    // maps them to the screen
+    void setScan(uint16_t lines, uint16_t blank_lines, uint8_t madctl);
+
+    // Queue w x h RGB565 pixels at (x, y) in bands that follow the scan; data
+    // must stay valid until !isBusy(). Returns false if the frame wasn't
+    // taken (TE not measured yet, or the image is partly off screen).
+    bool presentImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data);
+    bool isBusy() const { return _pending; }
+    bool wait(uint32_t timeout_ms = 1000);
+
+    uint32_t periodUs() const { return _period_ns / 1000; }  // 0 until measured
+
+private:
+    HAL& _hal;
+    int8_t _pin_te;
+
+    // Written by the TE interrupt
+    volatile uint64_t _te_us;       // Last rising edge
+    volatile uint32_t _period_ns;   // Filtered TE period
+
+    // Scan geometry for the current rotation
+    uint16_t _lines;
+    uint16_t _blank_lines;
+    bool _scan_x;                   // Gate lines run along screen x (MADCTL_MV)
+    bool _reversed;                 // Gate line 0 at the far edge (MADCTL_MY)
+
+    // Frame being presented
+    int16_t _x, _y, _w, _h;
+    const uint16_t* _data;
+    ScanBand _bands[MAX_BANDS];
+    size_t _band_count;
+    volatile size_t _band_pos;      // Next band for the alarm to queue
+    volatile size_t _band_done;     // Bands sent
+    volatile bool _pending;
+    bool _tear_free;
+
+    // Bus time per pixel, from the SPI clock and then from finished bands
+    uint32_t _pixel_ps;
+    uint64_t _submit_us[MAX_BANDS];
+    uint64_t _bus_free_us;
+
+    void onTe();
+    int64_t onAlarm();
+    void onBandDone();
+    void submitBand(const ScanBand& band);
+
+    friend void te_irq_handler();
+    friend int64_t te_band_alarm(alarm_id_t id, void* user_data);
+    friend void te_band_done(void* context);
+};
+
+} // namespace dcs
+} // namespace displays
@@ -1,83 +1,84 @@
 #pragma once
 
-#include "ili9341_config.hpp"
-#include "ili9341_hal.hpp"
-#include "ili9341_gfx.hpp"
+#include "displays/dcs/dcs.hpp"
 
 namespace ili9341 {
 
-// Main ILI9341 LCD control class
-class ILI9341 {
-private:
-    HAL _hal;                   // Hardware abstraction layer
-    Graphics _gfx;              // Graphics functionality
-    bool _initialized;          // Initialization flag
-    
-    // Internal functions
-    void initializeDisplay();
-    
-public:
-    ILI9341();
-    virtual ~ILI9341();
-    
-    // Display initialization
-    bool begin(const Config& config = Config());
-    bool begin(spi_inst_t* spi, uint8_t cs_pin, uint8_t dc_pin, 
-              uint8_t rst_pin, uint8_t bl_pin = 10,
-              uint16_t width = 240, uint16_t height = 320);
-    
-    // Display control
-    void setRotation(Rotation rotation);
-    Rotation getRotation() { return _hal.getConfig().rotation; }
-    void invertDisplay(bool invert);
-    void fillScreen(uint16_t color);
-    void sleepDisplay(bool sleep);
-    void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
-    
-    // Screen clearing
-    void clearScreen(uint16_t color = BLACK) { _gfx.clearScreen(_hal.getConfig().width, _hal.getConfig().height, color); }
-    
-    // DMA related functions
-    bool isDmaEnabled() const { return _hal.isDmaEnabled(); }
-    bool isDmaBusy() const { return _hal.isDmaBusy(); }
-    
-    // Efficient drawing functions using DMA
-    bool drawImageDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data);
-    bool fillRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
-    
-    // Hardware control
-    void setBacklight(bool on);
-    void setBrightness(uint8_t brightness);
-    void reset();
-    
-    // Color conversion utilities
-    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
-        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-    }
-    
-    // Ensure proper color format for ILI9341
-    static uint16_t correctColor(uint16_t color) {
-        return color; // RGB565 is already in correct format for RGB mode
+using namespace displays::dcs;
+
+// ILI9341 command definitions (beyond the DCS set)
+enum Command {
+    ILI9341_GAMMASET    = 0x26,
+    ILI9341_FRMCTR1     = 0xB1,
+    ILI9341_BPC         = 0xB5,
+    ILI9341_DFUNCTR     = 0xB6,
+    ILI9341_PWCTR1      = 0xC0,
+    ILI9341_PWCTR2      = 0xC1,
+    ILI9341_VMCTR1      = 0xC5,
+    ILI9341_VMCTR2      = 0xC7,
+    ILI9341_PWCTRA      = 0xCB,
+    ILI9341_PWCTRB      = 0xCF,
+    ILI9341_GMCTRP1     = 0xE0,
+    ILI9341_GMCTRN1     = 0xE1,
+    ILI9341_DTCTRA      = 0xE8,
+    ILI9341_DTCTRB      = 0xEA,
+    ILI9341_PWRSEQ      = 0xED,
+    ILI9341_EN3G        = 0xF2,
+    ILI9341_PUMPCTR     = 0xF7
+};
+
+struct Traits {
+    static constexpr const char* NAME = "ILI9341";
+    static constexpr uint16_t WIDTH = 240;
+    static constexpr uint16_t HEIGHT = 320;
+    static constexpr bool RGB444 = false;   // Only 16 or 18 bits per pixel over SPI
+    static constexpr uint16_t TE_BLANK_LINES = 4;   // VFP + VBP, power-on defaults
+
+    // BGR order for color correction
+    static constexpr Orientation ORIENTATIONS[4] = {
+        {MADCTL_MY | MADCTL_BGR, 0, 0},
+        {MADCTL_MX | MADCTL_MY | MADCTL_MV | MADCTL_BGR, 0, 0},
+        {MADCTL_MX | MADCTL_BGR, 0, 0},
+        {MADCTL_MV | MADCTL_BGR, 0, 0}
+    };
+
+    // 615 kHz / (RTNA clocks per line * (gate lines + VFP + VBP))
+    static constexpr FrameRateModel FRAME_RATE = {615000, 0, 1, 0x10, 0x1F, 2, 127};
+
+    static void writeFrameRate(HAL& hal, const FrameRateSetting& setting) {
+        uint8_t frmctr1[2] = {0x00, setting.rtna};            // Oscillator not divided
+        hal.writeCommand(ILI9341_FRMCTR1, frmctr1, 2);
+        uint8_t bpc[4] = {setting.front_porch, setting.back_porch, 0x0A, 0x14};  // HFP/HBP defaults
+        hal.writeCommand(ILI9341_BPC, bpc, 4);
     }
-    
-    // Access to other components
-    Graphics& graphics() { return _gfx; }
-    HAL& hal() { return _hal; }
-    
-    // Drawing functions 
-    void drawPixel(int16_t x, int16_t y, uint16_t color) { _gfx.drawPixel(x, y, color); }
-    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) { _gfx.drawLine(x0, y0, x1, y1, color); }
-    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { _gfx.drawRect(x, y, w, h, color); }
-    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { _gfx.fillRect(x, y, w, h, color); }
-    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) { _gfx.drawCircle(x0, y0, r, color); }
-    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) { _gfx.fillCircle(x0, y0, r, color); }
-    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) { _gfx.drawTriangle(x0, y0, x1, y1, x2, y2, color); }
-    void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) { _gfx.drawChar(x, y, c, color, bg, size); }
-    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) { _gfx.drawString(x, y, str, color, bg, size); }
-    void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) { _gfx.drawImage(x, y, w, h, data); }
-    
-    // Friend declarations
-    friend class Graphics;
+
+    static constexpr InitCommand INIT[] = {
+        // Configured in sleep mode, straight after the hardware reset
+        {ILI9341_PWCTRA, 5, {0x39, 0x2C, 0x00, 0x34, 0x02}, 0},
+        {ILI9341_PWCTRB, 3, {0x00, 0xC1, 0x30}, 0},
+        {ILI9341_DTCTRA, 3, {0x85, 0x00, 0x78}, 0},
+        {ILI9341_DTCTRB, 2, {0x00, 0x00}, 0},
+        {ILI9341_PWRSEQ, 4, {0x64, 0x03, 0x12, 0x81}, 0},
+        {ILI9341_PUMPCTR, 1, {0x20}, 0},
+        {ILI9341_PWCTR1, 1, {0x23}, 0},
+        {ILI9341_PWCTR2, 1, {0x10}, 0},
+        {ILI9341_VMCTR1, 2, {0x3E, 0x28}, 0},
+        {ILI9341_VMCTR2, 1, {0x86}, 0},
+        {DCS_MADCTL, 1, {0x48}, 0},
+        {DCS_COLMOD, 1, {PIXEL_FORMAT_RGB565}, 0},
+        {ILI9341_FRMCTR1, 2, {0x00, 0x18}, 0},
+        {ILI9341_DFUNCTR, 3, {0x08, 0x82, 0x27}, 0},
+        {ILI9341_EN3G, 1, {0x00}, 0},                // Gamma function disable
+        {ILI9341_GAMMASET, 1, {0x01}, 0},
+        {ILI9341_GMCTRP1, 15, {0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
+                               0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00}, 0},
+        {ILI9341_GMCTRN1, 15, {0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
+                               0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F}, 0},
+        {DCS_SLPOUT, 0, {}, 5},                      // 5 ms before the next command
+        {DCS_DISPON, 0, {}, 0}
+    };
 };
 
+using ILI9341 = Panel<Traits>;
+
 } // namespace ili9341
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include "sh1107_config.hpp"
 #include "sh1107_hal.hpp"
 #include "sh1107_gfx.hpp"
+#include "sh1107_pack.hpp"
+#include "displays/common/image_region.hpp"
 
 namespace sh1107 {
 
@@ -12,6 +15,11 @@ private:
     Graphics _gfx;
     bool _initialized;
 
+    static constexpr int MAX_WIDTH = MAX_PAGE_WIDTH;
+    uint8_t _page_buf[MAX_WIDTH];   // One page row, built before it is sent
+
+    void drawRegion(const displays::ImageRegion& region);
+
 public:
     SH1107();
     virtual ~SH1107();
@@ -20,8 +28,13 @@ public:
     void setRotation(Rotation rotation);
     void clearScreen(uint16_t color = 0x0000);
     void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data);
+    void drawImageRegions(const displays::ImageRegion* regions, size_t count);
     void setBrightness(uint8_t v) { _hal.setContrast(v); }
     void invertDisplay(bool invert);
+
+    // Over I2C with DMA, drawing returns while the last page goes out
+    bool waitForDmaComplete() { return _hal.waitForDmaComplete(); }
+    uint32_t pagesSent() const { return _hal.pagesSent(); }
 };
 
 } // namespace sh1107
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include "hardware/spi.h"
+#include "hardware/i2c.h"
 
 namespace sh1107 {
 
@@ -18,18 +19,41 @@ enum Rotation {
     ROTATION_270 = 3
 };
 
-// DMA placeholder
+// Transport: 4-wire SPI, or I2C for modules that only bring out SDA/SCL
+enum Bus {
+    BUS_SPI,
+    BUS_I2C
+};
+
+// Padding around each SPI transfer. TIMING_STABLE_3V3 holds CS for 2 us
+// either side and waits 5 us after a command, for marginal 3.3V supplies
+// and long wires; TIMING_FAST drops it for modules on a good supply.
+enum BusTiming {
+    TIMING_STABLE_3V3,
+    TIMING_FAST
+};
+
+// BUS_I2C: stream page data to the I2C block by DMA (SPI writes are blocking)
 struct DmaConfig {
     bool enabled;
     uint dma_tx_channel;
-    size_t buffer_size;
-    DmaConfig() : enabled(false), dma_tx_channel(0), buffer_size(0) {}
+    DmaConfig() : enabled(false), dma_tx_channel(0) {}
 };
 
 struct Config {
+    Bus bus;
+
     spi_inst_t* spi_inst;
     uint32_t spi_speed_hz;
 
+    // BUS_I2C: the module's SA0 pin picks address 0x3C or 0x3D. CS and DC
+    // aren't used; RST is optional on these modules but still driven.
+    i2c_inst_t* i2c_inst;
+    uint32_t i2c_speed_hz;
+    uint8_t i2c_address;
+    uint8_t pin_sda;
+    uint8_t pin_scl;
+
     uint8_t pin_din;   // MOSI
     uint8_t pin_sck;   // SCK
     uint8_t pin_cs;    // CS
@@ -46,10 +70,17 @@ struct Config {
     // Power supply adaptive settings
     bool low_power_mode;  // Reduces contrast and clock speed for unstable power
     uint8_t initial_contrast; // Starting contrast value
+    BusTiming timing;         // SPI padding
 
     Config() :
+        bus(BUS_SPI),
         spi_inst(spi1),
         spi_speed_hz(4 * 1000 * 1000), // default 4MHz for 3.3V stability
+        i2c_inst(i2c1),
+        i2c_speed_hz(1000 * 1000),     // Fast-mode Plus
+        i2c_address(0x3C),
+        pin_sda(26),
+        pin_scl(27),
         pin_din(11),
         pin_sck(10),
         pin_cs(9),
@@ -61,7 +92,8 @@ struct Config {
         rotation(ROTATION_0),
         dma(),
         low_power_mode(true), // Enable low power by default for 3.3V
-        initial_contrast(0x20) {} // Very low default contrast for 3.3V
+        initial_contrast(0x20), // Very low default contrast for 3.3V
+        timing(TIMING_STABLE_3V3) {}
 };
 
 } // namespace sh1107
@@ -2,8 +2,10 @@
 
 #include "sh1107_config.hpp"
 #include "hardware/spi.h"
+#include "hardware/i2c.h"
 #include "hardware/gpio.h"
 #include <cstdint>
+#include <cstddef>
 
 namespace sh1107 {
 
@@ -11,10 +13,26 @@ class HAL {
 private:
     Config _config;
     bool _initialized;
+    uint32_t _pages_sent;
+
+    // BUS_I2C: each transaction is built as IC_DATA_CMD words (data byte,
+    // STOP on the last one) in one buffer while the other is going out
+    static constexpr size_t I2C_MAX_DATA = 128;
+    static constexpr size_t I2C_PAGE_HEADER = 7;    // 3 framed commands + data control byte
+    uint16_t _i2c_words[2][I2C_PAGE_HEADER + I2C_MAX_DATA];
+    int _i2c_next;
+    bool _i2c_busy;
+    int _dma_channel;
 
     void spi_init_hw();
+    void i2c_init_hw();
     void send_command(uint8_t cmd);
+    void send_commands(const uint8_t* cmds, size_t len);
     void send_data(const uint8_t* data, size_t len);
+    void pad(uint8_t stable_us) const;
+
+    void i2cStart(const uint16_t* words, size_t count);
+    bool i2cWait();
 
 public:
     HAL();
@@ -27,9 +45,16 @@ public:
 
     // Basic writes (8-bit data)
     void writeCommand(uint8_t cmd);
+    void writeCommands(const uint8_t* cmds, size_t len);    // One CS frame or I2C transaction
     void writeData(uint8_t data);
     void writeDataBuffer(const uint8_t* buffer, size_t length);
 
+    // Set the page and start column and write len bytes of the page. Over
+    // I2C it's one transaction, and with DMA it returns while it goes out
+    void writePage(uint8_t page, uint8_t column, const uint8_t* data, size_t len);
+    bool waitForDmaComplete() { return i2cWait(); }
+    uint32_t pagesSent() const { return _pages_sent; }
+
     void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
 
     const Config& getConfig() const { return _config; }
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include "displays/common/image_region.hpp"
+
+namespace sh1107 {
+
+// Widest page the SH1107 has (128 columns)
+constexpr int MAX_PAGE_WIDTH = 128;
+
+// Threshold w RGB565 pixels to 1bpp, row-major: pixel i is bit (i & 7) of
+// bits[i / 8], set when its luma (R + 2G + B) / 4 is over 128
+void packRow(const uint16_t* src, int w, uint8_t* bits);
+
+// Eight 1bpp rows (a null row is blank) to the w column-major bytes of a
+// page: bit r of page[i] is pixel i of rows[r]. Every 8 columns are one
+// 8x8 bit transpose.
+void transposePage(const uint8_t* const rows[8], int w, uint8_t* page);
+
+// Page `page` of region for the w columns from screen column draw_x, which
+// must lie inside the region. Rows of the page outside it are left dark.
+void buildPage(const displays::ImageRegion& region, int page, int draw_x, int w, uint8_t* out);
+
+// Transpose of an 8x8 bit matrix held with row r in byte r and column c in
+// bit c: bit 8r + c moves to bit 8c + r (three delta swaps, of 1x1, 2x2
+// and 4x4 blocks)
+inline uint64_t transpose8x8(uint64_t x) {
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+} // namespace sh1107
@@ -1,76 +1,68 @@
 #pragma once
 
-#include "st7789_config.hpp"
-#include "st7789_hal.hpp"
-#include "st7789_gfx.hpp"
+#include "displays/dcs/dcs.hpp"
 
 namespace st7789 {
 
-// Main LCD control class
-class ST7789 {
-private:
-    HAL _hal;                   // Hardware abstraction layer
-    Graphics _gfx;              // Graphics functionality
-    bool _initialized;          // Initialization flag
-    
-    // Internal functions
-    void initializeDisplay();
-    void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
-    
-public:
-    ST7789();
-    virtual ~ST7789();
-    
-    // Display initialization
-    bool begin(const Config& config = Config());
-    bool begin(spi_inst_t* spi, uint8_t cs_pin, uint8_t dc_pin, 
-              uint8_t rst_pin, uint8_t bl_pin = 10,
-              uint16_t width = 240, uint16_t height = 320);
-    
-    // Display control
-    void setRotation(Rotation rotation);
-    Rotation getRotation() { return _hal.getConfig().rotation; }  // Get current rotation angle
-    void invertDisplay(bool invert);
-    void fillScreen(uint16_t color);
-    void sleepDisplay(bool sleep);
-    
-    // Screen clearing
-    void clearScreen(uint16_t color = BLACK) { _gfx.clearScreen(_hal.getConfig().width, _hal.getConfig().height, color); }
-    
-    // DMA related functions
-    bool isDmaEnabled() const { return _hal.isDmaEnabled(); }
-    bool isDmaBusy() const { return _hal.isDmaBusy(); }
-    
-    // Efficient drawing functions using DMA
-    bool drawImageDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data);
-    bool fillRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
-    
-    // Hardware control
-    void setBacklight(bool on);
-    void setBrightness(uint8_t brightness);
-    void reset();
-    
-    // Access to other components
-    Graphics& graphics() { return _gfx; }
-    HAL& hal() { return _hal; }
-    
-    // Convenient drawing functions (passed to graphics class)
-    void drawPixel(int16_t x, int16_t y, uint16_t color) { _gfx.drawPixel(x, y, color); }
-    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) { _gfx.drawLine(x0, y0, x1, y1, color); }
-    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { _gfx.drawRect(x, y, w, h, color); }
-    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { _gfx.fillRect(x, y, w, h, color); }
-    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) { _gfx.drawCircle(x0, y0, r, color); }
-    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) { _gfx.fillCircle(x0, y0, r, color); }
-    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) { _gfx.drawTriangle(x0, y0, x1, y1, x2, y2, color); }
-    void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) { _gfx.drawChar(x, y, c, color, bg, size); }
-    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) { _gfx.drawString(x, y, str, color, bg, size); }
-    void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) { _gfx.drawImage(x, y, w, h, data); }
-    
-    // Static helper functions
-    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) { return Graphics::color565(r, g, b); }
-    
-    // Friend declarations
-    friend class Graphics;
+using namespace displays::dcs;
+
+// ST7789 command definitions (beyond the DCS set)
+enum Command {
+    ST7789_RAMCTRL = 0xB0,
+    ST7789_PORCTRL = 0xB2,
+    ST7789_GCTRL   = 0xB7,
+    ST7789_VCOMS   = 0xBB,
+    ST7789_LCMCTRL = 0xC0,
+    ST7789_VDVVRHEN= 0xC2,
+    ST7789_VRHS    = 0xC3,
+    ST7789_VDVS    = 0xC4,
+    ST7789_FRCTRL2 = 0xC6,
+    ST7789_PWCTRL1 = 0xD0,
+    ST7789_PVGAMCTRL = 0xE0,
+    ST7789_NVGAMCTRL = 0xE1
+};
+
+struct Traits {
+    static constexpr const char* NAME = "ST7789";
+    static constexpr uint16_t WIDTH = 240;
+    static constexpr uint16_t HEIGHT = 320;
+    static constexpr bool RGB444 = true;
+    static constexpr uint16_t TE_BLANK_LINES = 24;   // PORCTRL 0x0C + 0x0C
+
+    static constexpr Orientation ORIENTATIONS[4] = {
+        {0x00, 0, 0},
+        {MADCTL_MX | MADCTL_MV, 0, 0},
+        {MADCTL_MY | MADCTL_MX, 0, 0},
+        {MADCTL_MY | MADCTL_MV, 0, 0}
+    };
+
+    // 10 MHz / ((250 + 16 * RTNA) * (gate lines + FPA + BPA))
+    static constexpr FrameRateModel FRAME_RATE = {10000000, 250, 16, 0x00, 0x1F, 1, 127};
+
+    static void writeFrameRate(HAL& hal, const FrameRateSetting& setting) {
+        uint8_t porctrl[5] = {setting.back_porch, setting.front_porch, 0x00, 0x33, 0x33};
+        hal.writeCommand(ST7789_PORCTRL, porctrl, 5);
+        hal.writeCommand(ST7789_FRCTRL2, &setting.rtna, 1);
+    }
+
+    static constexpr InitCommand INIT[] = {
+        {DCS_SLPOUT, 0, {}, 5},                     // 5 ms before the next command
+        {DCS_COLMOD, 1, {PIXEL_FORMAT_RGB565}, 0},
+        {DCS_MADCTL, 1, {0x00}, 0},
+        {ST7789_FRCTRL2, 1, {0x0F}, 0},             // 60Hz
+        {DCS_INVON, 0, {}, 0},
+        {ST7789_PORCTRL, 5, {0x0C, 0x0C, 0x00, 0x33, 0x33}, 0},
+        {ST7789_GCTRL, 1, {0x35}, 0},
+        {ST7789_VCOMS, 1, {0x28}, 0},
+        {ST7789_LCMCTRL, 1, {0x0C}, 0},
+        {ST7789_VDVVRHEN, 2, {0x01, 0xFF}, 0},
+        {ST7789_VRHS, 1, {0x10}, 0},
+        {ST7789_VDVS, 1, {0x20}, 0},
+        {DCS_NORON, 0, {}, 0},
+        {DCS_DISPON, 0, {}, 0}
+    };
 };
 
-} // namespace st7789 
\ No newline at end of file
+using ST7789 = Panel<Traits>;
+
+} // namespace st7789
@@ -1,76 +1,66 @@
 #pragma once
 
-#include "st7796_config.hpp"
-#include "st7796_hal.hpp"
-#include "st7796_gfx.hpp"
+#include "displays/dcs/dcs.hpp"
 
 namespace st7796 {
 
-// Main ST7796 LCD control class
-class ST7796 {
-private:
-    HAL _hal;                   // Hardware abstraction layer
-    Graphics _gfx;              // Graphics functionality
-    bool _initialized;          // Initialization flag
-    
-    // Internal functions
-    void initializeDisplay();
-    
-public:
-    ST7796();
-    virtual ~ST7796();
-    
-    // Display initialization
-    bool begin(const Config& config = Config());
-    bool begin(spi_inst_t* spi, uint8_t cs_pin, uint8_t dc_pin, 
-              uint8_t rst_pin, uint8_t bl_pin = 10,
-              uint16_t width = 320, uint16_t height = 480);
-    
-    // Display control
-    void setRotation(Rotation rotation);
-    Rotation getRotation() { return _hal.getConfig().rotation; }  // Get current rotation angle
-    void invertDisplay(bool invert);
-    void fillScreen(uint16_t color);
-    void sleepDisplay(bool sleep);
-    void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
-    
-    // Screen clearing
-    void clearScreen(uint16_t color = BLACK) { _gfx.clearScreen(_hal.getConfig().width, _hal.getConfig().height, color); }
-    
-    // DMA related functions
-    bool isDmaEnabled() const { return _hal.isDmaEnabled(); }
-    bool isDmaBusy() const { return _hal.isDmaBusy(); }
-    
-    // Efficient drawing functions using DMA
-    bool drawImageDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data);
-    bool fillRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
-    
-    // Hardware control
-    void setBacklight(bool on);
-    void setBrightness(uint8_t brightness);
-    void reset();
-    
-    // Access to other components
-    Graphics& graphics() { return _gfx; }
-    HAL& hal() { return _hal; }
-    
-    // Convenient drawing functions (passed to graphics class)
-    void drawPixel(int16_t x, int16_t y, uint16_t color) { _gfx.drawPixel(x, y, color); }
-    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) { _gfx.drawLine(x0, y0, x1, y1, color); }
-    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { _gfx.drawRect(x, y, w, h, color); }
-    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { _gfx.fillRect(x, y, w, h, color); }
-    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) { _gfx.drawCircle(x0, y0, r, color); }
-    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) { _gfx.fillCircle(x0, y0, r, color); }
-    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) { _gfx.drawTriangle(x0, y0, x1, y1, x2, y2, color); }
-    void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) { _gfx.drawChar(x, y, c, color, bg, size); }
-    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) { _gfx.drawString(x, y, str, color, bg, size); }
-    void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) { _gfx.drawImage(x, y, w, h, data); }
-    
-    // Static helper functions
-    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) { return Graphics::color565(r, g, b); }
-    
-    // Friend declarations
-    friend class Graphics;
+using namespace displays::dcs;
+
+// ST7796 command definitions (beyond the DCS set)
+enum Command {
+    ST7796_DFUNCTR     = 0xB6,
+    ST7796_PWCTR1      = 0xC0,
+    ST7796_PWCTR2      = 0xC1,
+    ST7796_PWCTR3      = 0xC2,
+    ST7796_VMCTR1      = 0xC5,
+    ST7796_VMOFCTR     = 0xC6,
+    ST7796_GMCTRP1     = 0xE0,
+    ST7796_GMCTRN1     = 0xE1,
+    ST7796_CSCON       = 0xF0
 };
 
+struct Traits {
+    static constexpr const char* NAME = "ST7796";
+    static constexpr uint16_t WIDTH = 320;
+    static constexpr uint16_t HEIGHT = 480;
+    static constexpr bool RGB444 = true;
+    static constexpr uint16_t TE_BLANK_LINES = 4;   // VFP + VBP, power-on defaults
+
+    // RGB order (no MADCTL_BGR) to fix red/blue swap
+    static constexpr Orientation ORIENTATIONS[4] = {
+        {MADCTL_MX, 0, 0},
+        {MADCTL_MV, 0, 0},
+        {MADCTL_MY, 0, 0},
+        {MADCTL_MX | MADCTL_MY | MADCTL_MV, 0, 0}
+    };
+
+    // Refresh rate left at the init table's setting
+    static constexpr FrameRateModel FRAME_RATE = {};
+
+    static constexpr InitCommand INIT[] = {
+        {DCS_SLPOUT, 0, {}, 5},                     // 5 ms before the next command
+        {ST7796_CSCON, 1, {0xC3}, 0},               // Enable extension command 2 part I
+        {ST7796_CSCON, 1, {0x96}, 0},               // Enable extension command 2 part II
+        {DCS_MADCTL, 1, {0x40}, 0},
+        {DCS_COLMOD, 1, {PIXEL_FORMAT_RGB565}, 0},
+        {ST7796_DFUNCTR, 3, {0x80, 0x02, 0x3B}, 0}, // Bypass, S1-S960/G1-G480, 8*(59+1) lines
+        {ST7796_PWCTR1, 1, {0x80}, 0},              // VRH=4.8V
+        {ST7796_PWCTR2, 1, {0x13}, 0},              // VDV=1.2V
+        {ST7796_PWCTR3, 1, {0xA7}, 0},              // VDS=-1V
+        {ST7796_VMCTR1, 2, {0x09, 0x09}, 0},        // VCOMH=3.2V, VCOML=-0.9V
+        {ST7796_VMOFCTR, 1, {0x22}, 0},
+        {ST7796_GMCTRP1, 14, {0xF0, 0x09, 0x0B, 0x06, 0x04, 0x15, 0x2F,
+                              0x54, 0x42, 0x3C, 0x17, 0x14, 0x18, 0x1B}, 0},
+        {ST7796_GMCTRN1, 14, {0xE0, 0x09, 0x0B, 0x06, 0x04, 0x03, 0x2B,
+                              0x43, 0x42, 0x3B, 0x16, 0x14, 0x17, 0x1B}, 0},
+        {ST7796_CSCON, 1, {0x3C}, 0},               // Disable extension command 2 part I
+        {ST7796_CSCON, 1, {0x69}, 0},               // Disable extension command 2 part II
+        {DCS_INVOFF, 0, {}, 0},
+        {DCS_NORON, 0, {}, 0},
+        {DCS_DISPON, 0, {}, 0}
+    };
+};
+
+using ST7796 = Panel<Traits>;
+
 } // namespace st7796
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include "hardware/dma.h"
+
+// Owner of the DMA channels and of both DMA interrupt lines. Every module
+// claims its channels here instead of from the SDK, optionally with a
+// completion handler; one shared handler per line (DMA_IRQ_0 and
+// DMA_IRQ_1) clears each finished channel's flag and calls its handler.
+// The panel queue, the palette lookup and any capture DMA can then run at
+// the same time without taking an interrupt line for themselves.
+class DmaChannels {
+public:
+    // Called from the DMA interrupt when the channel raises its IRQ flag
+    typedef void (*Handler)(void* context);
+
+    // A free channel, or -1. With a handler the channel's completion is
+    // routed to it on interrupt line irq_index (0 or 1).
+    static int claim(Handler handler = nullptr, void* context = nullptr, uint irq_index = 0);
+    static void unclaim(int channel);
+
+    // Stop a channel without delivering a completion for it (the abort can
+    // raise a spurious one, RP2040-E13)
+    static void abort(uint channel);
+
+    static bool isClaimed(uint channel) { return _claimed & (1u << channel); }
+    static uint32_t claimedMask() { return _claimed; }
+
+private:
+    struct Slot {
+        Handler handler;
+        void* context;
+    };
+
+    static Slot _slots[NUM_DMA_CHANNELS];
+    static uint32_t _claimed;           // Channels claimed through here
+    static uint32_t _routed[2];         // Channels with a handler, per line
+    static bool _installed[2];
+
+    static void dispatch(uint irq_index);
+    static void irq0();
+    static void irq1();
+};
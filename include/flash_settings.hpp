@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// A few bytes of settings kept across boots in the last flash sector. The
+// record carries a key (build a hash of whatever the value depends on) and a
+// checksum, so a value saved for other wiring or clocks, or a blank sector,
+// reads as missing. Reflashing keeps the sector: a value that depends on
+// the code must put a build identity (e.g. __DATE__ __TIME__) in its key.
+class FlashSettings {
+public:
+    static constexpr size_t MAX_DATA = 64;
+
+    static bool load(uint32_t key, void* data, size_t len);
+
+    // Erases and programs the sector unless it already holds the same value.
+    // The flash is off the bus meanwhile: interrupts are disabled, and no DMA
+    // may be reading from flash (e.g. a queued logo).
+    static bool save(uint32_t key, const void* data, size_t len);
+
+    // FNV-1a, chained through seed to build keys from several fields
+    static uint32_t hash(const void* data, size_t len, uint32_t seed = 2166136261u);
+};
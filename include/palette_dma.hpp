@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "hardware/spi.h"
+#include "hardware/pio.h"
+
+// Streams a frame of 2-bit pixel indices to an SPI panel as RGB565 without
+// the CPU touching each pixel. Three DMA channels and a PIO state machine
+// form the lookup:
+// - feed: index words -> PIO TX FIFO
+// - PIO (palette_lookup.pio): index -> palette entry address -> RX FIFO
+// - addr: RX FIFO -> data channel READ_ADDR trigger
+// - data: 2 bytes from the palette entry -> SPI TX, then chains to addr
+// The end-of-frame marker becomes a null trigger, which stops the chain.
+// If no PIO state machine or DMA channels are free, frames are expanded
+// and sent by the CPU instead.
+class PaletteDma {
+public:
+    // Indices must be stored as INDEX_MARK | shade (shade 0-3, capture order)
+    static constexpr uint8_t INDEX_MARK = 0x04;
+    // Extra bytes the index buffer needs after the last pixel
+    static constexpr size_t PADDING = 4;
+
+    PaletteDma();
+    ~PaletteDma();
+
+    // - palette: RGB565 colors in capture order (PaletteTables::rgb565)
+    bool init(spi_inst_t* spi, uint8_t pin_cs, uint8_t pin_dc, PIO pio, const uint16_t palette[4]);
+    void setPalette(const uint16_t palette[4]);
+
+    // Send count pixels as RAMWR data; the caller has already set the
+    // address window. indices must be word aligned with PADDING spare bytes.
+    // Returns as soon as the transfer is running (immediately in DMA mode).
+    void start(uint8_t* indices, size_t count);
+    bool isBusy() const;
+    void wait();
+
+    bool isDmaEnabled() const { return _dma_enabled; }
+
+private:
+    spi_inst_t* _spi;
+    uint8_t _pin_cs;
+    uint8_t _pin_dc;
+    PIO _pio;
+    int _sm;
+    uint _offset;
+    int _ch_feed;
+    int _ch_addr;
+    int _ch_data;
+    bool _dma_enabled;
+    bool _busy;
+
+    // Palette entries in SPI byte order, 8-byte aligned for the PIO address math
+    alignas(8) uint16_t _table[4];
+
+    void release();
+    void finish();
+    void writeSoftware(const uint8_t* indices, size_t count);
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+// 12-bit RGB444 packing (COLMOD 0x53): two pixels share three bytes,
+// R1G1 B1R2 G2B2, cutting the bytes per pixel from 2 to 1.5.
+
+// Build the pair table used by packRowRgb444: entry (a << 2) | b holds the
+// three bytes for capture index a followed by capture index b.
+// - rgb444: palette as 0x0RGB values in capture order (PaletteTables::rgb444)
+void buildRgb444PairLut(const uint16_t rgb444[4], uint8_t lut[16][3]);
+
+// Scale and pack one row of 2-bit capture indices into RGB444 bytes.
+// - src: source row of capture indices (0-3)
+// - xmap: destination x -> source x map from buildScaleMaps
+// - width: destination width in pixels, must be even
+// - dst: width * 3 / 2 output bytes
+void packRowRgb444(const uint8_t* src, const int* xmap, int width,
+                   const uint8_t lut[16][3], uint8_t* dst);
@@ -6,9 +6,13 @@
 #include "scaler.hpp"
 #include "dither.hpp"
 #include "palettes.hpp"
+#include "pixel_pack.hpp"
+#include "palette_dma.hpp"
+#include "clock_profile.hpp"
 #include <stdbool.h>
 #include "hardware/pio.h"
 #include "hardware/spi.h"
+#include "hardware/clocks.h"
 #include "gblcd.pio.h"
 
 // Choose display type: uncomment one of these lines
@@ -18,6 +22,10 @@
 //#define USE_ST7796
 //#define USE_SH1107
 
+// System clock (include/clock_profile.hpp): 125, 133, 200 or 250 MHz, with clk_peri following it.
+// SPI rates are clk_peri / 2, / 4, / 6..., so a faster clock gives finer and higher SPI steps
+#define CLOCK_PROFILE CLOCK_PROFILE_125
+
 // Uncomment to enable dithering for monochrome display
 //#define ENABLE_BW_DITHER
 
@@ -26,11 +34,62 @@
 // DITHER_BEST - Floyd-Steinberg error diffusion (best quality, higher performance cost)
 #define DITHER_BEST
 
-// Palette selection
+// Palette selection (palettes are defined in include/palettes.txt)
 #define SELECTED_PALETTE PALETTE_MODERN2
 
 //#define ENABLE_ST7789_NEGATIVE_FILM
 
+// Uncomment to send 12-bit RGB444 pixels (ST7789/ST7796 only): 25% fewer SPI bytes per frame
+//#define ENABLE_RGB444
+
+// Uncomment to expand palette indices to RGB565 with chained DMA instead of the CPU
+// (TFT panels in RGB565 mode); the SPI transfer then overlaps the next capture
+//#define ENABLE_PALETTE_DMA
+
+// Uncomment to clock the TFT from a PIO state machine (pio/lcd_spi) instead of the SPI block;
+// CS and DC are driven by the PIO program. Needs PIN_SCK == PIN_CS + 1
+//#define ENABLE_PIO_BUS
+
+// Uncomment to drive the TFT over its 8080 parallel interface (8 or 16 data bits, pio/lcd_8080)
+// instead of SPI: data on GPIO PIN_D0 onwards, WR on PIN_SCK, RD tied high (ILI9341/ST7796 modules)
+//#define PARALLEL_BUS_WIDTH 8
+
+// Uncomment and wire the panel's TE (tearing effect) output to this GPIO to send frames
+// in step with the panel's refresh, so they never tear (TFT panels in RGB565 mode)
+//#define PIN_TE 14
+
+// Uncomment to set the panel's refresh to the Game Boy's ~59.73 Hz, timed from its vsync, so one
+// refresh shows one frame (ILI9341/ILI9342/ST7789); with PIN_TE it's trimmed from the panel's real rate
+//#define ENABLE_REFRESH_MATCH
+
+// Uncomment and wire the panel's SDO (MISO) to this GPIO to pick the SPI clock at boot: rates
+// up to SPI_TUNE_MAX_HZ are written, read back and timed, and the result is kept in flash
+//#define PIN_MISO 28
+#define SPI_TUNE_MAX_HZ (62500 * 1000)
+
+// Uncomment to put TFT panels in partial mode: only the gate lines under the game area are
+// refreshed and the rest shows the controller's non-display level (not FILL_COLOR)
+//#define ENABLE_PARTIAL_MODE
+
+// Uncomment to mirror the picture to a second panel of the same type on spi0 (PIN_MIRROR_*),
+// with its own size, scale and placement (MIRROR_*); both panels are sent to by DMA at once
+//#define ENABLE_MIRROR
+
+// Uncomment for SH1107 modules wired over I2C (PIN_SDA, PIN_SCL) instead of SPI: pages are
+// streamed to the I2C block by DMA at Fast-mode Plus (1 MHz)
+//#define SH1107_I2C
+
+// Uncomment when the SH1107 is on a good 3.3V supply with short wires: drops the microsecond
+// padding kept around every SPI transfer for marginal supplies
+//#define SH1107_FAST_TIMING
+
+// Uncomment to print the average CPU cycles spent per frame on scaling and display output
+// (and the SH1107's page rate)
+//#define ENABLE_FRAME_STATS
+
+// Uncomment to print the time from reset to panel ready and to the first captured frame on screen
+//#define ENABLE_BOOT_STATS
+
 // Force BW dither for SH1107 monochrome display
 #if defined(USE_SH1107)
     #ifndef ENABLE_BW_DITHER
@@ -46,6 +105,21 @@
 #define PIN_DC 12
 #define PIN_RESET 13
 #define PIN_BL 8
+#define PIN_D0 15   // First of PARALLEL_BUS_WIDTH data pins
+
+// SH1107 over I2C (SH1107_I2C)
+#define I2C_CHANNEL i2c1
+#define PIN_SDA 26
+#define PIN_SCL 27
+
+// Second panel for ENABLE_MIRROR
+#define MIRROR_SPI_CHANNEL spi0
+#define PIN_MIRROR_MOSI 19
+#define PIN_MIRROR_SCK 18
+#define PIN_MIRROR_CS 17
+#define PIN_MIRROR_DC 20
+#define PIN_MIRROR_RESET 21
+#define PIN_MIRROR_BL 22
 
 #define DMG_W 160
 #define DMG_H 144
@@ -59,6 +133,7 @@
         #define X_OFF 26
         #define DISPLAY_ROTATION st7789::ROTATION_270
         #define FILL_COLOR st7789::WHITE
+        #define PANEL_PALETTES palettes::st7789
         #define DISPLAY_SCALE 1.67
     #else
         #define LCD_W 240
@@ -67,6 +142,7 @@
         #define X_OFF 0
         #define DISPLAY_ROTATION st7789::ROTATION_0
         #define FILL_COLOR st7789::BLACK
+        #define PANEL_PALETTES palettes::st7789
         #define DISPLAY_SCALE 1.5
     #endif
 #elif defined(USE_ILI9341)
@@ -77,6 +153,7 @@
     #define X_OFF 46   
     #define DISPLAY_ROTATION ili9341::ROTATION_270
     #define FILL_COLOR ili9341::BLACK
+    #define PANEL_PALETTES palettes::ili9341
     #define DISPLAY_SCALE 1.6
 #elif defined(USE_ILI9342)
     #include "displays/ili9342/ili9342.hpp"
@@ -86,6 +163,7 @@
     #define X_OFF 40
     #define DISPLAY_ROTATION ili9342::ROTATION_0
     #define FILL_COLOR ili9342::BLACK
+    #define PANEL_PALETTES palettes::ili9342
     #define DISPLAY_SCALE 1.5
 #elif defined(USE_ST7796)
     #include "displays/st7796/st7796.hpp"
@@ -95,6 +173,7 @@
     #define X_OFF 0
     #define DISPLAY_ROTATION st7796::ROTATION_180
     #define FILL_COLOR st7796::BLACK
+    #define PANEL_PALETTES palettes::st7796
     #define DISPLAY_SCALE 2
 #elif defined(USE_SH1107)
     #include "displays/sh1107/sh1107.hpp"
@@ -105,6 +184,11 @@
     #define DISPLAY_ROTATION sh1107::ROTATION_180
     #define FILL_COLOR sh1107::BLACK
     #define DISPLAY_SCALE 0.8
+    #ifdef SH1107_I2C
+        #define SH1107_BUS_NAME "I2C"
+    #else
+        #define SH1107_BUS_NAME "SPI"
+    #endif
 #else
     #error "Please define a display type"
 #endif
@@ -112,61 +196,250 @@
 #define SCALED_W (int)(DMG_W * DISPLAY_SCALE + 0.5f)
 #define SCALED_H (int)(DMG_H * DISPLAY_SCALE + 0.5f)
 
+#ifdef ENABLE_MIRROR
+    // The mirror copies the first panel's layout unless these are set
+    #ifndef MIRROR_W
+        #define MIRROR_W LCD_W
+        #define MIRROR_H LCD_H
+    #endif
+    #ifndef MIRROR_ROTATION
+        #define MIRROR_ROTATION DISPLAY_ROTATION
+    #endif
+    #ifndef MIRROR_SCALE
+        #define MIRROR_SCALE DISPLAY_SCALE
+    #endif
+    #ifndef MIRROR_X_OFF
+        #define MIRROR_X_OFF X_OFF
+        #define MIRROR_Y_OFF Y_OFF
+    #endif
+    #define MIRROR_SCALED_W (int)(DMG_W * MIRROR_SCALE + 0.5f)
+    #define MIRROR_SCALED_H (int)(DMG_H * MIRROR_SCALE + 0.5f)
+#endif
+
+#ifdef ENABLE_RGB444
+    #if !defined(USE_ST7789) && !defined(USE_ST7796)
+        #error "ENABLE_RGB444 needs a panel with 12-bit SPI support (ST7789 or ST7796)"
+    #endif
+    #ifdef ENABLE_BW_DITHER
+        #error "ENABLE_RGB444 can't be combined with ENABLE_BW_DITHER"
+    #endif
+    static_assert(SCALED_W % 2 == 0, "RGB444 packing needs an even scaled width");
+#endif
+
+#ifdef ENABLE_PALETTE_DMA
+    #if defined(USE_SH1107) || defined(ENABLE_RGB444)
+        #error "ENABLE_PALETTE_DMA needs a TFT panel in RGB565 mode"
+    #endif
+#endif
+
+#ifdef ENABLE_PIO_BUS
+    #if defined(USE_SH1107) || defined(ENABLE_PALETTE_DMA)
+        #error "ENABLE_PIO_BUS needs a TFT panel, and ENABLE_PALETTE_DMA writes to the SPI block directly"
+    #endif
+    static_assert(PIN_SCK == PIN_CS + 1, "The PIO bus side-sets CS and SCK, which must be adjacent");
+#endif
+
+#ifdef PARALLEL_BUS_WIDTH
+    #if defined(USE_SH1107) || defined(ENABLE_PALETTE_DMA) || defined(ENABLE_PIO_BUS)
+        #error "PARALLEL_BUS_WIDTH needs a TFT panel, without ENABLE_PALETTE_DMA or ENABLE_PIO_BUS"
+    #endif
+    #if defined(ENABLE_RGB444) && PARALLEL_BUS_WIDTH == 16
+        #error "ENABLE_RGB444 packs pixels into bytes, which only the 8-bit bus sends as they are"
+    #endif
+    static_assert(PARALLEL_BUS_WIDTH == 8 || PARALLEL_BUS_WIDTH == 16, "The 8080 bus is 8 or 16 bits wide");
+    static_assert(PIN_SCK == PIN_CS + 1, "The 8080 bus side-sets CS and WR (PIN_SCK), which must be adjacent");
+    static_assert(PIN_D0 + PARALLEL_BUS_WIDTH <= 29, "The data pins must be consecutive GPIOs");
+#endif
+
+#ifdef ENABLE_MIRROR
+    #if defined(USE_SH1107) || defined(ENABLE_RGB444) || defined(ENABLE_PALETTE_DMA)
+        #error "ENABLE_MIRROR needs a TFT panel in RGB565 mode without ENABLE_PALETTE_DMA"
+    #endif
+    #ifdef PARALLEL_BUS_WIDTH
+        #error "ENABLE_MIRROR's pins are taken by the 8080 data bus; move them to combine the two"
+    #endif
+    // Same scale: one scaled frame is sent to both panels
+    static constexpr bool MIRROR_SHARES_FRAME = (float)MIRROR_SCALE == (float)DISPLAY_SCALE;
+#endif
+
+#ifdef PIN_MISO
+    #if defined(USE_SH1107) || defined(ENABLE_PIO_BUS) || defined(PARALLEL_BUS_WIDTH) || defined(ENABLE_PALETTE_DMA)
+        #error "PIN_MISO tuning needs a TFT panel on the SPI block"
+    #endif
+#endif
+
+#if (defined(SH1107_I2C) || defined(SH1107_FAST_TIMING)) && !defined(USE_SH1107)
+    #error "SH1107_I2C and SH1107_FAST_TIMING need USE_SH1107"
+#endif
+
+#ifdef ENABLE_PARTIAL_MODE
+    #ifdef USE_SH1107
+        #error "ENABLE_PARTIAL_MODE needs a TFT panel"
+    #endif
+    #ifdef ENABLE_REFRESH_MATCH
+        #error "ENABLE_REFRESH_MATCH sets the normal mode refresh registers, which partial mode doesn't use"
+    #endif
+#endif
+
+#ifdef ENABLE_REFRESH_MATCH
+    #if !defined(USE_ILI9341) && !defined(USE_ILI9342) && !defined(USE_ST7789)
+        #error "ENABLE_REFRESH_MATCH needs a panel with a refresh rate model (ILI9341, ILI9342, ST7789)"
+    #endif
+    #define GB_FRAME_US 16743           // Nominal, to count frames missed between vsyncs
+    #define REFRESH_MATCH_FRAMES 300    // Re-match every ~5 s
+#endif
+
+#ifdef PIN_TE
+    #if defined(USE_SH1107) || defined(ENABLE_RGB444) || defined(ENABLE_PALETTE_DMA)
+        #error "PIN_TE needs a TFT panel in RGB565 mode without ENABLE_PALETTE_DMA"
+    #endif
+#endif
+
 static const uint16_t BW_BLACK = 0x0000;
 static const uint16_t BW_WHITE = 0xFFFF;
 
 // Palettes setup
 #ifdef ENABLE_BW_DITHER
     #ifdef DITHER_BEST
-        static const uint16_t gb_colors[4] = {
-            0xFFFF, 0xAAAA, 0x4444, 0x0000
-        };
+        static const uint16_t* gb_colors = PALETTE_BW_DITHER_BEST.rgb565;
     #else
-        static const uint16_t gb_colors[4] = {
-            0xFFFF, 0x9999, 0x5555, 0x0000
-        };
+        static const uint16_t* gb_colors = PALETTE_BW_DITHER_FAST.rgb565;
     #endif
 #else
-    static const uint16_t* gb_colors = SELECTED_PALETTE;
+    // Palette with the panel's colour correction (include/panels.txt) applied
+    static const uint16_t* gb_colors = PANEL_PALETTES::SELECTED_PALETTE.rgb565;
+#endif
+
+// Frame memory, sized at compile time from the options above. One object in
+// uninitialized RAM: every byte is written by the capture, the scaler or
+// setup before it's read, so crt0 doesn't spend boot time zeroing it, and its
+// size shows up as a single symbol in the link map. It stays in the striped
+// main SRAM, which spreads the panel DMA and CPU accesses over all four banks;
+// none of it is a DMA ring buffer, so word alignment is all the DMA needs.
+struct FrameBuffers {
+#if defined(ENABLE_RGB444)
+    uint8_t screen[DMG_W * DMG_H];                  // Capture indices
+    alignas(4) uint8_t packed[SCALED_W * SCALED_H * 3 / 2];
+#elif defined(ENABLE_PALETTE_DMA)
+    uint8_t screen[DMG_W * DMG_H];                  // Capture indices
+    alignas(4) uint8_t scaled[SCALED_W * SCALED_H + PaletteDma::PADDING];
+#else
+    alignas(4) uint16_t screen[DMG_W * DMG_H];
+    alignas(4) uint16_t scaled[SCALED_W * SCALED_H];
+    #ifdef ENABLE_MIRROR
+    // A second frame and maps only when the mirror's scale differs
+    alignas(4) uint16_t mirror[MIRROR_SHARES_FRAME ? 1 : MIRROR_SCALED_W * MIRROR_SCALED_H];
+    int mirrorXmap[MIRROR_SHARES_FRAME ? 1 : MIRROR_SCALED_W];
+    int mirrorYmap[MIRROR_SHARES_FRAME ? 1 : MIRROR_SCALED_H];
+    #endif
+#endif
+};
+static_assert(sizeof(FrameBuffers) <= 240 * 1024, "Frame buffers leave too little RAM for the drivers and stack");
+static FrameBuffers __uninitialized_ram(frame);
+
+// The scaler reads a map entry for every pixel it writes. In the scratch
+// banks (SRAM4 and SRAM5) those reads don't compete with the panel DMA in
+// main SRAM. Each bank also holds a 2 KB stack (core 1's is unused).
+static int __scratch_x("scale_map") scaleXmap[SCALED_W];
+static int __scratch_y("scale_map") scaleYmap[SCALED_H];
+static_assert(sizeof(scaleXmap) <= 2048 && sizeof(scaleYmap) <= 2048, "Scale maps don't fit beside the stacks");
+
+#if !defined(ENABLE_RGB444) && !defined(ENABLE_PALETTE_DMA)
+static void scaleFrame(const uint16_t* src, const int* xmap, const int* ymap, int w, int h, uint16_t* dst) {
+    if (w == DMG_W && h == DMG_H && xmap[w - 1] == w - 1 && ymap[h - 1] == h - 1) {  // 1:1
+        memcpy(dst, src, DMG_W * DMG_H * sizeof(uint16_t));
+        return;
+    }
+    for (int dy = 0; dy < h; dy++) {
+        const uint16_t* srcRow = &src[ ymap[dy] * DMG_W ];
+        uint16_t* dstRow = &dst[ dy * w ];
+        int dx = 0;
+        for (; dx <= w - 8; dx += 8) {
+            dstRow[dx] = srcRow[xmap[dx]];
+            dstRow[dx + 1] = srcRow[xmap[dx + 1]];
+            dstRow[dx + 2] = srcRow[xmap[dx + 2]];
+            dstRow[dx + 3] = srcRow[xmap[dx + 3]];
+            dstRow[dx + 4] = srcRow[xmap[dx + 4]];
+            dstRow[dx + 5] = srcRow[xmap[dx + 5]];
+            dstRow[dx + 6] = srcRow[xmap[dx + 6]];
+            dstRow[dx + 7] = srcRow[xmap[dx + 7]];
+        }
+        for (; dx < w; dx++) {
+            dstRow[dx] = srcRow[xmap[dx]];
+        }
+    }
+}
+#endif
+
+#ifdef ENABLE_BW_DITHER
+static void ditherFrame(uint16_t* buf, int w, int h) {
+    #if defined(DITHER_BEST)
+    floyd_steinberg_dither(buf, w, h, gb_colors, BW_WHITE, BW_BLACK);
+    #else
+    fast_bayer_dither(buf, w, h, gb_colors, BW_WHITE, BW_BLACK);
+    #endif
+}
+#endif
+
+#ifndef USE_SH1107
+// Frames only ever cover the game area, so the rest of the screen is
+// filled once, without sending the game area again
+template <typename Panel>
+static void fillBorders(Panel& panel, int x, int y, int w, int h, uint16_t color) {
+    int right = x + w;
+    int bottom = y + h;
+    panel.fillRect(0, 0, panel.width(), y, color);
+    panel.fillRect(0, bottom, panel.width(), panel.height() - bottom, color);
+    panel.fillRect(0, y, x, h, color);
+    panel.fillRect(right, y, panel.width() - right, h, color);
+}
 #endif
 
 int main() {
+    // Clocks first: SPI and PIO dividers are worked out from them
+    bool clock_applied = applyClockProfile(CLOCK_PROFILE);
     stdio_init_all();
+    logClockProfile(CLOCK_PROFILE, clock_applied);
+
+    // PIO setup, before the panel: the state machine only waits on the
+    // Game Boy's clock, so capture comes up while the panel initializes.
+    // It samples on the clock edges rather than on a divided clock, so its
+    // timing holds at every clock profile.
+    PIO pio = pio0; // gblcd.pio
+    uint state_machine_id = 0;
+    uint offset = pio_add_program(pio, &gblcd_program);
+    gblcd_program_init(pio, state_machine_id, offset);
     
 #ifdef USE_ST7789
     st7789::ST7789 lcd;
     st7789::Config config;
     config.spi_speed_hz = 40 * 1000 * 1000;
-    config.dma.buffer_size = 480;
     config.dma.enabled = true;
 #elif defined(USE_ILI9341)
     ili9341::ILI9341 lcd;
     ili9341::Config config;
     config.spi_speed_hz = 40 * 1000 * 1000;
-    config.dma.buffer_size = 2560;
     config.dma.enabled = true;
 #elif defined(USE_ILI9342)
     ili9342::ILI9342 lcd;
     ili9342::Config config;
     config.spi_speed_hz = 40 * 1000 * 1000;
-    config.dma.buffer_size = 960;
     config.dma.enabled = true;
 #elif defined(USE_ST7796)
     st7796::ST7796 lcd;
     st7796::Config config;
     config.spi_speed_hz = 62.5 * 1000 * 1000;
-    config.dma.buffer_size = 4096;
     config.dma.enabled = true;
 #elif defined(USE_SH1107)
     sh1107::SH1107 lcd;
     sh1107::Config config;
     config.spi_speed_hz = 8 * 1000 * 1000;
     config.dma.enabled = true;
-    config.dma.buffer_size = 256;
 #endif
 
     // Set common config values
     config.width = LCD_W;
+    config.height = LCD_H;
     config.spi_inst = SPI_CHANNEL;
     config.pin_din = PIN_MOSI;
     config.pin_sck = PIN_SCK;
@@ -175,17 +448,71 @@ int main() {
     config.pin_reset = PIN_RESET;
     config.pin_bl = PIN_BL;
     config.rotation = DISPLAY_ROTATION;
+#ifdef ENABLE_PIO_BUS
+    config.pio_bus = true;
+#endif
+#ifdef PARALLEL_BUS_WIDTH
+    config.bus_width = PARALLEL_BUS_WIDTH;
+    config.pin_wr = PIN_SCK;
+    config.pin_d0 = PIN_D0;
+#endif
+#ifdef PIN_TE
+    config.pin_te = PIN_TE;
+#endif
+#ifdef PIN_MISO
+    config.pin_miso = PIN_MISO;
+    config.spi_max_hz = SPI_TUNE_MAX_HZ;
+#endif
+#ifdef SH1107_FAST_TIMING
+    config.timing = sh1107::TIMING_FAST;
+#endif
+#ifdef SH1107_I2C
+    config.bus = sh1107::BUS_I2C;
+    config.i2c_inst = I2C_CHANNEL;
+    config.pin_sda = PIN_SDA;
+    config.pin_scl = PIN_SCL;
+#endif
     
     lcd.begin(config);
     lcd.setRotation(config.rotation);
+#ifdef ENABLE_MIRROR
+    // Same controller and bus settings on its own pins; its transfer queue
+    // has its own DMA channels, so both panels stream at the same time
+    decltype(lcd) mirror;
+    decltype(config) mirrorConfig = config;
+    mirrorConfig.width = MIRROR_W;
+    mirrorConfig.height = MIRROR_H;
+    mirrorConfig.spi_inst = MIRROR_SPI_CHANNEL;
+    mirrorConfig.pin_din = PIN_MIRROR_MOSI;
+    mirrorConfig.pin_sck = PIN_MIRROR_SCK;
+    mirrorConfig.pin_cs = PIN_MIRROR_CS;
+    mirrorConfig.pin_dc = PIN_MIRROR_DC;
+    mirrorConfig.pin_reset = PIN_MIRROR_RESET;
+    mirrorConfig.pin_bl = PIN_MIRROR_BL;
+    mirrorConfig.pin_te = -1;
+    mirrorConfig.pin_miso = -1;
+    mirrorConfig.rotation = MIRROR_ROTATION;
+    mirror.begin(mirrorConfig);
+    mirror.setRotation(mirrorConfig.rotation);
+#endif
+#ifdef ENABLE_BOOT_STATS
+    uint32_t boot_panel_us = time_us_32();
+    bool boot_reported = false;
+#endif
 
 #if defined(USE_SH1107)
     lcd.setBrightness(64);
 #elif defined(USE_ILI9341)
     lcd.setBrightness(255);
+    #ifdef ENABLE_MIRROR
+    mirror.setBrightness(255);
+    #endif
 #endif
 
     lcd.clearScreen(RMODS_LOGO_BACKGROUND);
+#ifdef ENABLE_MIRROR
+    mirror.clearScreen(RMODS_LOGO_BACKGROUND);
+#endif
     
 #ifdef ENABLE_TEST_COLOR
     // Test color rendering to verify display driver works
@@ -220,14 +547,13 @@ int main() {
     #endif
     int logo_x = (int)(X_OFF + (SCALED_W - logo_width) / 2);
     int logo_y = (int)(Y_OFF + (SCALED_H - logo_height) / 2);
+    // Stays up until the first Game Boy frame replaces it
     lcd.drawImage(logo_x, logo_y, logo_width, logo_height, logo);
-    sleep_ms(1000);
-
-    // PIO setup
-    PIO pio = pio0; // gblcd.pio
-    uint state_machine_id = 0;
-    uint offset = pio_add_program(pio, &gblcd_program);
-    gblcd_program_init(pio, state_machine_id, offset);
+#ifdef ENABLE_MIRROR
+    mirror.drawImage((int)(MIRROR_X_OFF + (MIRROR_SCALED_W - logo_width) / 2),
+                     (int)(MIRROR_Y_OFF + (MIRROR_SCALED_H - logo_height) / 2),
+                     logo_width, logo_height, logo);
+#endif
 
     int x = 0, y = 0;
     bool vSyncPrev = false;
@@ -235,14 +561,55 @@ int main() {
     bool vSyncFallingEdgeDetected = false;
     bool firstRun = false;
 
-    static uint16_t screenBuffer[DMG_W * DMG_H];
-    static uint16_t scaledBuf[SCALED_W * SCALED_H];
+#ifdef ENABLE_RGB444
+    // Capture indices, packed straight into RGB444 bytes
+    uint8_t* screenBuffer = frame.screen;
+    uint8_t* packedBuf = frame.packed;
+    static uint8_t rgb444_lut[16][3];
+    buildRgb444PairLut(PANEL_PALETTES::SELECTED_PALETTE.rgb444, rgb444_lut);
+#elif defined(ENABLE_PALETTE_DMA)
+    // Capture indices, scaled as bytes and expanded to RGB565 by DMA
+    uint8_t* screenBuffer = frame.screen;
+    uint8_t* scaledIdx = frame.scaled;
+    static PaletteDma expander;
+    expander.init(SPI_CHANNEL, PIN_CS, PIN_DC, pio1, gb_colors);
+#else
+    uint16_t* screenBuffer = frame.screen;
+    uint16_t* scaledBuf = frame.scaled;
+#endif
     uint16_t data0, data1, vSync;
 
-    static int xmap[SCALED_W];
-    static int ymap[SCALED_H];
+    int* xmap = scaleXmap;
+    int* ymap = scaleYmap;
     buildScaleMaps(xmap, ymap, DMG_W, DMG_H, SCALED_W, SCALED_H, DISPLAY_SCALE);
 
+#ifdef ENABLE_MIRROR
+    uint16_t* mirrorBuf = MIRROR_SHARES_FRAME ? scaledBuf : frame.mirror;
+    int* mirrorXmap = frame.mirrorXmap;
+    int* mirrorYmap = frame.mirrorYmap;
+    if (!MIRROR_SHARES_FRAME) {
+        buildScaleMaps(mirrorXmap, mirrorYmap, DMG_W, DMG_H, MIRROR_SCALED_W, MIRROR_SCALED_H, MIRROR_SCALE);
+    }
+#endif
+
+#ifdef ENABLE_REFRESH_MATCH
+    uint64_t refresh_first_us = 0;
+    uint64_t refresh_last_us = 0;
+#endif
+
+#ifdef ENABLE_FRAME_STATS
+    const uint32_t cycles_per_us = clock_get_hz(clk_sys) / 1000000;
+    uint32_t stats_us = 0;
+    uint32_t stats_frames = 0;
+    #ifdef USE_SH1107
+    uint32_t stats_push_us = 0;
+    uint32_t stats_pages = lcd.pagesSent();
+    #endif
+#endif
+
+    // Drop samples that piled up in the FIFO while the panel started
+    pio_sm_clear_fifos(pio, state_machine_id);
+
     while (true) {
         uint32_t result = pio_sm_get_blocking(pio, state_machine_id);
         vSync = (result >> 31) & 1;
@@ -255,13 +622,37 @@ int main() {
             continue;
         }
 
+#ifdef ENABLE_REFRESH_MATCH
+        refresh_last_us = time_us_64();
+        if (refresh_first_us == 0) {
+            refresh_first_us = refresh_last_us;
+        }
+#endif
+
         if (!firstRun) {
             firstRun = true;
+#ifdef USE_SH1107
             lcd.clearScreen(FILL_COLOR);
+#else
+            fillBorders(lcd, X_OFF, Y_OFF, SCALED_W, SCALED_H, FILL_COLOR);
+    #ifdef ENABLE_PARTIAL_MODE
+            lcd.setPartialArea(X_OFF, Y_OFF, SCALED_W, SCALED_H);
+    #endif
+#endif
+#ifdef ENABLE_MIRROR
+            fillBorders(mirror, MIRROR_X_OFF, MIRROR_Y_OFF, MIRROR_SCALED_W, MIRROR_SCALED_H, FILL_COLOR);
+    #ifdef ENABLE_PARTIAL_MODE
+            mirror.setPartialArea(MIRROR_X_OFF, MIRROR_Y_OFF, MIRROR_SCALED_W, MIRROR_SCALED_H);
+    #endif
+#endif
         }
 
         // ---- Capture 160x144 into screenBuffer ----
+#if defined(ENABLE_RGB444) || defined(ENABLE_PALETTE_DMA)
+        uint8_t* bufPtr = screenBuffer;
+#else
         uint16_t* bufPtr = screenBuffer;
+#endif
         
         for (y = 0; y < DMG_H; y++) {
             for (x = 0; x < DMG_W; x++) {
@@ -274,43 +665,146 @@ int main() {
                 // Game Boy pixel format: LD1,LD0 forms 2-bit value (0-3)
                 uint8_t gb_pixel_value = (data1 << 1) | data0;
                 
+#if defined(ENABLE_RGB444)
+                *bufPtr++ = gb_pixel_value;
+#elif defined(ENABLE_PALETTE_DMA)
+                *bufPtr++ = PaletteDma::INDEX_MARK | gb_pixel_value;
+#else
                 *bufPtr++ = gb_colors[gb_pixel_value];
+#endif
             }
         }
 
-        if (DISPLAY_SCALE == 1) {
-            memcpy(scaledBuf, screenBuffer, DMG_W * DMG_H * sizeof(uint16_t));
+#ifdef ENABLE_FRAME_STATS
+        uint32_t frame_start_us = time_us_32();
+#endif
+
+#ifdef ENABLE_RGB444
+        // drawImageRGB444 returns while the last frame is still going out of packedBuf
+        lcd.waitForDmaComplete();
+
+        const int packedRow = SCALED_W * 3 / 2;
+        for (int dy = 0; dy < SCALED_H; dy++) {
+            uint8_t* dstRow = &packedBuf[dy * packedRow];
+            if (dy > 0 && ymap[dy] == ymap[dy - 1]) {
+                // Repeated source row: reuse the row packed above
+                memcpy(dstRow, dstRow - packedRow, packedRow);
+            } else {
+                packRowRgb444(&screenBuffer[ymap[dy] * DMG_W], xmap, SCALED_W, rgb444_lut, dstRow);
+            }
         }
-        else {
-            for (int dy = 0; dy < SCALED_H; dy++) {
-                const uint16_t* srcRow = &screenBuffer[ ymap[dy] * DMG_W ];
-                uint16_t* dstRow = &scaledBuf[ dy * SCALED_W ];
-                int dx = 0;
-                for (; dx <= SCALED_W - 8; dx += 8) {
-                    dstRow[dx] = srcRow[xmap[dx]];
-                    dstRow[dx + 1] = srcRow[xmap[dx + 1]];
-                    dstRow[dx + 2] = srcRow[xmap[dx + 2]];
-                    dstRow[dx + 3] = srcRow[xmap[dx + 3]];
-                    dstRow[dx + 4] = srcRow[xmap[dx + 4]];
-                    dstRow[dx + 5] = srcRow[xmap[dx + 5]];
-                    dstRow[dx + 6] = srcRow[xmap[dx + 6]];
-                    dstRow[dx + 7] = srcRow[xmap[dx + 7]];
-                }
-                for (; dx < SCALED_W; dx++) {
-                    dstRow[dx] = srcRow[xmap[dx]];
-                }
+
+        lcd.drawImageRGB444(X_OFF, Y_OFF, SCALED_W, SCALED_H, packedBuf);
+#elif defined(ENABLE_PALETTE_DMA)
+        // The previous frame may still be streaming out of scaledIdx
+        expander.wait();
+        for (int dy = 0; dy < SCALED_H; dy++) {
+            uint8_t* dstRow = &scaledIdx[dy * SCALED_W];
+            if (dy > 0 && ymap[dy] == ymap[dy - 1]) {
+                memcpy(dstRow, dstRow - SCALED_W, SCALED_W);
+                continue;
+            }
+            const uint8_t* srcRow = &screenBuffer[ymap[dy] * DMG_W];
+            for (int dx = 0; dx < SCALED_W; dx++) {
+                dstRow[dx] = srcRow[xmap[dx]];
             }
         }
-        
+
+        lcd.setAddrWindow(X_OFF, Y_OFF, X_OFF + SCALED_W - 1, Y_OFF + SCALED_H - 1);
+        lcd.waitForDmaComplete();  // window commands are queued
+        expander.start(scaledIdx, SCALED_W * SCALED_H);
+#else
+    #ifndef USE_SH1107
+        // drawImage returns while the last frame is still going out of scaledBuf
+        lcd.waitForDmaComplete();
+    #endif
+
+    #ifdef ENABLE_MIRROR
+        if (MIRROR_SHARES_FRAME) {
+            mirror.waitForDmaComplete();  // Also reads scaledBuf
+        }
+    #endif
+
+        scaleFrame(screenBuffer, xmap, ymap, SCALED_W, SCALED_H, scaledBuf);
 #ifdef ENABLE_BW_DITHER
-    #if defined(DITHER_BEST)
-        floyd_steinberg_dither(scaledBuf, SCALED_W, SCALED_H, gb_colors, BW_WHITE, BW_BLACK);
+        ditherFrame(scaledBuf, SCALED_W, SCALED_H);
+#endif
+
+    #if defined(ENABLE_FRAME_STATS) && defined(USE_SH1107)
+        uint32_t push_start_us = time_us_32();
+    #endif
+
+    #ifdef PIN_TE
+        lcd.presentImage(X_OFF, Y_OFF, SCALED_W, SCALED_H, scaledBuf);
     #else
-        fast_bayer_dither(scaledBuf, SCALED_W, SCALED_H, gb_colors, BW_WHITE, BW_BLACK);
+        lcd.drawImage(X_OFF, Y_OFF, SCALED_W, SCALED_H, scaledBuf);
+    #endif
+
+    #if defined(ENABLE_FRAME_STATS) && defined(USE_SH1107)
+        // Up to the last page's STOP, so the rate is the bus's
+        lcd.waitForDmaComplete();
+        stats_push_us += time_us_32() - push_start_us;
+    #endif
+
+    #ifdef ENABLE_MIRROR
+        if (!MIRROR_SHARES_FRAME) {
+            // Scaled while the first panel's frame is going out
+            mirror.waitForDmaComplete();
+            scaleFrame(screenBuffer, mirrorXmap, mirrorYmap, MIRROR_SCALED_W, MIRROR_SCALED_H, mirrorBuf);
+        #ifdef ENABLE_BW_DITHER
+            ditherFrame(mirrorBuf, MIRROR_SCALED_W, MIRROR_SCALED_H);
+        #endif
+        }
+        mirror.drawImage(MIRROR_X_OFF, MIRROR_Y_OFF, MIRROR_SCALED_W, MIRROR_SCALED_H, mirrorBuf);
     #endif
 #endif
 
-        lcd.drawImage(X_OFF, Y_OFF, SCALED_W, SCALED_H, scaledBuf);
+#ifdef ENABLE_BOOT_STATS
+        if (!boot_reported) {
+            boot_reported = true;
+    #if defined(ENABLE_PALETTE_DMA)
+            expander.wait();
+    #else
+            lcd.waitForDmaComplete();
+    #endif
+    #ifdef ENABLE_MIRROR
+            mirror.waitForDmaComplete();
+    #endif
+            // The timer starts at reset, so these count from power-on
+            printf("Boot: panel ready %lu ms, first frame on screen %lu ms\n",
+                   (unsigned long)(boot_panel_us / 1000), (unsigned long)(time_us_32() / 1000));
+        }
+#endif
+
+#ifdef ENABLE_FRAME_STATS
+        stats_us += time_us_32() - frame_start_us;
+        if (++stats_frames == 60) {
+            printf("Display path: %lu cycles/frame\n",
+                   (unsigned long)(stats_us / stats_frames * cycles_per_us));
+    #ifdef USE_SH1107
+            uint32_t pages = lcd.pagesSent() - stats_pages;
+            if (pages && stats_push_us) {
+                printf("SH1107 %s: %lu us/page, %lu pages/s\n", SH1107_BUS_NAME,
+                       (unsigned long)(stats_push_us / pages),
+                       (unsigned long)((uint64_t)pages * 1000000 / stats_push_us));
+            }
+            stats_push_us = 0;
+            stats_pages = lcd.pagesSent();
+    #endif
+            stats_us = 0;
+            stats_frames = 0;
+        }
+#endif
+#ifdef ENABLE_REFRESH_MATCH
+        // Vsyncs missed while drawing still count, by rounding to whole frames
+        uint64_t refresh_span_us = refresh_last_us - refresh_first_us;
+        uint32_t refresh_frames = (uint32_t)((refresh_span_us + GB_FRAME_US / 2) / GB_FRAME_US);
+        if (refresh_frames >= REFRESH_MATCH_FRAMES) {
+            lcd.waitForDmaComplete();
+            lcd.matchRefreshPeriod((uint32_t)(refresh_span_us / refresh_frames));
+            refresh_first_us = refresh_last_us;
+        }
+#endif
         vSyncFallingEdgeDetected = false;
     }
     return 0;
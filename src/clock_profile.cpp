@@ -0,0 +1,51 @@
+#include "clock_profile.hpp"
+#include <cstdio>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/vreg.h"
+
+struct ProfileSetting {
+    uint32_t sys_khz;
+    enum vreg_voltage voltage;
+    const char* volts;
+};
+
+static const ProfileSetting PROFILES[] = {
+    {125000, VREG_VOLTAGE_1_10, "1.10"},
+    {133000, VREG_VOLTAGE_1_10, "1.10"},
+    {200000, VREG_VOLTAGE_1_15, "1.15"},
+    {250000, VREG_VOLTAGE_1_20, "1.20"}
+};
+
+bool applyClockProfile(ClockProfile profile) {
+    const ProfileSetting& setting = PROFILES[profile];
+    uint vco_freq;
+    uint post_div1;
+    uint post_div2;
+    if (!check_sys_clock_khz(setting.sys_khz, &vco_freq, &post_div1, &post_div2)) {
+        return false;
+    }
+
+    // Core voltage up before the clock, and settled, so the core never
+    // runs faster than its supply allows
+    vreg_set_voltage(setting.voltage);
+    sleep_us(1000);
+    set_sys_clock_pll(vco_freq, post_div1, post_div2);
+
+    // set_sys_clock_pll moves clk_peri to the 48 MHz USB PLL unless the SDK
+    // is built with PICO_CLOCK_AJDUST_PERI_CLOCK_WITH_SYS_CLOCK
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS, sys_hz, sys_hz);
+    return true;
+}
+
+void logClockProfile(ClockProfile profile, bool applied) {
+    const ProfileSetting& setting = PROFILES[profile];
+    if (!applied) {
+        printf("Clock: %lu kHz isn't reachable from the PLL, sys stays at %lu Hz\n",
+               (unsigned long)setting.sys_khz, (unsigned long)clock_get_hz(clk_sys));
+        return;
+    }
+    printf("Clock: sys %lu Hz, peri %lu Hz, core %s V\n", (unsigned long)clock_get_hz(clk_sys),
+           (unsigned long)clock_get_hz(clk_peri), setting.volts);
+}
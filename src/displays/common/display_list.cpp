@@ -0,0 +1,86 @@
+#include "displays/common/display_list.hpp"
+#include <cstring>
+
+namespace displays {
+
+// MIPI DCS commands shared by all the supported controllers
+static const uint8_t DCS_CASET = 0x2A;
+static const uint8_t DCS_RASET = 0x2B;
+static const uint8_t DCS_RAMWR = 0x2C;
+
+DisplayList::DisplayList() : _count(0) {
+}
+
+void DisplayList::clear() {
+    _count = 0;
+}
+
+bool DisplayList::addCommand(uint8_t cmd, const uint8_t* params, size_t len) {
+    if (_count >= MAX_OPS || len > MAX_PARAMS) {
+        return false;
+    }
+
+    Op& op = _ops[_count++];
+    op.pixels = nullptr;
+    op.count = 0;
+    op.cmd = cmd;
+    op.param_len = (uint8_t)len;
+    if (len > 0) {
+        memcpy(op.params, params, len);
+    }
+    return true;
+}
+
+bool DisplayList::addPixels(const uint16_t* pixels, size_t count) {
+    if (count == 0) {
+        return true;
+    }
+    if (_count >= MAX_OPS || !pixels) {
+        return false;
+    }
+
+    Op& op = _ops[_count++];
+    op.pixels = pixels;
+    op.count = (uint32_t)count;
+    op.param_len = 0;
+    return true;
+}
+
+bool DisplayList::addRect(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                          const uint16_t* pixels, size_t stride) {
+    if (x1 < x0 || y1 < y0) {
+        return false;
+    }
+
+    size_t w = x1 - x0 + 1;
+    size_t h = y1 - y0 + 1;
+    size_t needed = 3 + ((stride == w) ? 1 : h);
+    if (_count + needed > MAX_OPS) {
+        return false;
+    }
+
+    uint8_t data[4];
+    data[0] = x0 >> 8;
+    data[1] = x0 & 0xFF;
+    data[2] = x1 >> 8;
+    data[3] = x1 & 0xFF;
+    addCommand(DCS_CASET, data, 4);
+
+    data[0] = y0 >> 8;
+    data[1] = y0 & 0xFF;
+    data[2] = y1 >> 8;
+    data[3] = y1 & 0xFF;
+    addCommand(DCS_RASET, data, 4);
+
+    addCommand(DCS_RAMWR);
+
+    if (stride == w) {
+        return addPixels(pixels, w * h);
+    }
+    for (size_t row = 0; row < h; row++) {
+        addPixels(pixels + row * stride, w);
+    }
+    return true;
+}
+
+} // namespace displays
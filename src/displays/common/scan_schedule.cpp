@@ -0,0 +1,51 @@
+#include "displays/common/scan_schedule.hpp"
+
+namespace displays {
+
+bool planScanBands(const ScanTiming& scan, uint16_t first, uint16_t last,
+                   uint32_t write_line_ns, BandOrder order,
+                   ScanBand* bands, size_t max_bands, size_t& count) {
+    count = 0;
+    if (last <= first || max_bands == 0 || scan.lines == 0) {
+        return false;
+    }
+
+    const int64_t line = scan.lineNs();
+    const int64_t write = write_line_ns;
+    const int64_t period = scan.period_ns;
+    const uint32_t band_lines = (last - first + max_bands - 1) / max_bands;
+
+    bool tear_free = true;
+    int64_t bus_free = 0;   // End of the previous band
+    for (uint32_t f = first; f < last; f += band_lines) {
+        uint32_t e = (f + band_lines < last) ? f + band_lines : last;
+        int64_t n = e - f;
+        int64_t read_start = (scan.blank_lines + f) * line;
+
+        // Earliest start that keeps every line's write after its read, and
+        // latest that finishes every line before the next refresh reads it
+        int64_t earliest, latest;
+        if (order == BAND_SEQUENTIAL) {
+            // Line L is written at start + (L - f) * write
+            earliest = read_start + line + ((line > write) ? (n - 1) * (line - write) : 0);
+            latest = period + read_start - write - ((write > line) ? (n - 1) * (write - line) : 0);
+        } else {
+            earliest = read_start + n * line;
+            latest = period + read_start - n * write;
+        }
+
+        int64_t start = (earliest > bus_free) ? earliest : bus_free;
+        if (start > latest) {
+            tear_free = false;
+        }
+
+        bands[count].first = (uint16_t)f;
+        bands[count].last = (uint16_t)e;
+        bands[count].start_ns = start;
+        count++;
+        bus_free = start + n * write;
+    }
+    return tear_free;
+}
+
+} // namespace displays
@@ -0,0 +1,738 @@
+#include "displays/common/transfer_queue.hpp"
+#include "dma_channels.hpp"
+#include "hardware/gpio.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+#include "pico/stdlib.h"
+#include "lcd_spi.pio.h"
+#include "lcd_8080.pio.h"
+#include <cstring>
+#include <cstdio>
+
+namespace displays {
+
+
+// PIO FIFO word for a byte: in every lane, as an 8-bit DMA write leaves it,
+// so it is left-justified for lcd_spi and lcd_8080_8 and on D0-D7 for
+// lcd_8080_16
+static inline uint32_t byteWord(uint8_t value) {
+    return value * 0x01010101u;
+}
+
+void transfer_queue_dma_done(void* context) {
+    ((TransferQueue*)context)->onDmaComplete();
+}
+
+TransferQueue::TransferQueue() :
+    _spi(nullptr),
+    _pin_cs(0),
+    _pin_dc(0),
+    _dma_channel(-1),
+    _ctrl_channel(-1),
+    _dma_dest(nullptr),
+    _frame_bits(8),
+    _initialized(false),
+    _pio(nullptr),
+    _pio_sm(0),
+    _pio_offset(0),
+    _pio_program(nullptr),
+    _head(0),
+    _tail(0),
+    _busy(false),
+    _list_pos(0),
+    _row_pos(0) {
+}
+
+TransferQueue::~TransferQueue() {
+    deinit();
+}
+
+bool TransferQueue::init(spi_inst_t* spi, uint8_t pin_cs, uint8_t pin_dc, bool use_dma) {
+    _spi = spi;
+    _pin_cs = pin_cs;
+    _pin_dc = pin_dc;
+    _frame_bits = 8;
+    _initialized = true;
+
+    if (!use_dma) {
+        return true;
+    }
+
+    _dma_channel = DmaChannels::claim(transfer_queue_dma_done, this);
+    if (_dma_channel < 0) {
+        printf("TransferQueue: no free DMA channel, using blocking transfers\n");
+        return true;
+    }
+
+    // Transfer size is set per job: bytes for data, halfwords for pixels
+    _dma_dest = &spi_get_hw(_spi)->dr;
+    _dma_config = dma_channel_get_default_config(_dma_channel);
+    channel_config_set_transfer_data_size(&_dma_config, DMA_SIZE_8);
+    channel_config_set_dreq(&_dma_config, spi_get_dreq(_spi, true));
+    channel_config_set_read_increment(&_dma_config, true);
+    channel_config_set_write_increment(&_dma_config, false);
+    dma_channel_configure(_dma_channel, &_dma_config, _dma_dest, nullptr, 0, false);
+
+    printf("TransferQueue: DMA channel %d\n", _dma_channel);
+    return true;
+}
+
+bool TransferQueue::usePioBus(uint8_t pin_sck, uint8_t pin_mosi, uint32_t baud_hz) {
+    if (!_initialized || _pio) {
+        return _pio != nullptr;
+    }
+    if (pin_sck != _pin_cs + 1) {
+        printf("TransferQueue: PIO bus needs SCK on CS + 1, staying on SPI\n");
+        return false;
+    }
+
+    PIO pio;
+    int sm = claimPio(&lcd_spi_program, pio);
+    if (sm < 0) {
+        printf("TransferQueue: no free PIO state machine, staying on SPI\n");
+        return false;
+    }
+
+    // Two state machine cycles per bit
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    float clk_div = (float)sys_hz / (2.0f * baud_hz);
+    if (clk_div < 1.0f) {
+        clk_div = 1.0f;
+    }
+
+    uint offset = pio_add_program(pio, &lcd_spi_program);
+    lcd_spi_program_init(pio, sm, offset, _pin_cs, pin_mosi, _pin_dc, clk_div);
+    attachPio(pio, sm, offset, &lcd_spi_program);
+
+    printf("TransferQueue: PIO%u SM %d bus at %u Hz\n",
+           pio_get_index(pio), sm, (unsigned)(sys_hz / (2.0f * clk_div)));
+    return true;
+}
+
+bool TransferQueue::useParallelBus(uint8_t pin_wr, uint8_t pin_d0, uint8_t width, uint32_t write_hz) {
+    if (!_initialized || _pio) {
+        return _pio != nullptr;
+    }
+    if (pin_wr != _pin_cs + 1 || (width != 8 && width != 16)) {
+        printf("TransferQueue: 8080 bus needs WR on CS + 1 and 8 or 16 data pins\n");
+        return false;
+    }
+
+    const pio_program_t* program = (width == 16) ? &lcd_8080_16_program : &lcd_8080_8_program;
+    PIO pio;
+    int sm = claimPio(program, pio);
+    if (sm < 0) {
+        printf("TransferQueue: no free PIO state machine for the 8080 bus\n");
+        return false;
+    }
+
+    // A write cycle is at least two state machine cycles
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    float clk_div = (float)sys_hz / (2.0f * write_hz);
+    if (clk_div < 1.0f) {
+        clk_div = 1.0f;
+    }
+
+    uint offset = pio_add_program(pio, program);
+    lcd_8080_program_init(pio, sm, offset, width, _pin_cs, pin_d0, _pin_dc, clk_div);
+    attachPio(pio, sm, offset, program);
+
+    printf("TransferQueue: PIO%u SM %d %u-bit 8080 bus at %u writes/s\n",
+           pio_get_index(pio), sm, width, (unsigned)(sys_hz / (2.0f * clk_div)));
+    return true;
+}
+
+// A state machine on a PIO with room for program, or -1
+int TransferQueue::claimPio(const pio_program_t* program, PIO& pio) {
+    // pio0 state machine 0 is taken by the Game Boy capture
+    PIO candidates[2] = {pio1, pio0};
+    for (PIO candidate : candidates) {
+        if (!pio_can_add_program(candidate, program)) {
+            continue;
+        }
+        int sm = pio_claim_unused_sm(candidate, false);
+        if (sm >= 0) {
+            pio = candidate;
+            return sm;
+        }
+    }
+    return -1;
+}
+
+// Switch the queue over to a state machine that is running program
+void TransferQueue::attachPio(PIO pio, uint sm, uint offset, const pio_program_t* program) {
+    waitIdle();
+    _pio = pio;
+    _pio_sm = sm;
+    _pio_offset = offset;
+    _pio_program = program;
+
+    if (_dma_channel >= 0) {
+        _dma_dest = &pio->txf[sm];
+        channel_config_set_dreq(&_dma_config, pio_get_dreq(pio, sm, true));
+
+        // Display lists: this channel copies each 4-word control block into
+        // the data channel's alias 1 registers, the last write triggering it
+        _ctrl_channel = DmaChannels::claim();
+        if (_ctrl_channel >= 0) {
+            dma_channel_config config = dma_channel_get_default_config(_ctrl_channel);
+            channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+            channel_config_set_read_increment(&config, true);
+            channel_config_set_write_increment(&config, true);
+            channel_config_set_ring(&config, true, 4);  // 16-byte write wrap
+            dma_channel_configure(_ctrl_channel, &config, &dma_hw->ch[_dma_channel].al1_ctrl,
+                                  nullptr, 4, false);
+        }
+    }
+}
+
+void TransferQueue::deinit() {
+    if (_busy) {
+        waitIdle();
+    }
+
+    if (_ctrl_channel >= 0) {
+        DmaChannels::unclaim(_ctrl_channel);
+        _ctrl_channel = -1;
+    }
+
+    if (_dma_channel >= 0) {
+        DmaChannels::unclaim(_dma_channel);
+        _dma_channel = -1;
+    }
+
+    if (_pio) {
+        pio_sm_set_enabled(_pio, _pio_sm, false);
+        pio_sm_unclaim(_pio, _pio_sm);
+        pio_remove_program(_pio, _pio_program, _pio_offset);
+        _pio = nullptr;
+    }
+
+    _initialized = false;
+}
+
+bool TransferQueue::submitCommand(uint8_t cmd, const uint8_t* params, size_t len) {
+    if (len > MAX_PARAMS) {
+        return false;
+    }
+
+    Job job = {};
+    job.type = JOB_COMMAND;
+    job.cmd = cmd;
+    job.param_len = (uint8_t)len;
+    if (len > 0) {
+        memcpy(job.params, params, len);
+    }
+    return submit(job);
+}
+
+bool TransferQueue::submitData(const uint8_t* data, size_t len, TransferCallback done, void* context) {
+    if (len == 0) {
+        if (done) done(context);
+        return true;
+    }
+
+    Job job = {};
+    job.type = JOB_DATA;
+    job.data = data;
+    job.len = len;
+    job.done = done;
+    job.context = context;
+    return submit(job);
+}
+
+bool TransferQueue::submitPixels(const uint16_t* pixels, size_t count, TransferCallback done, void* context) {
+    if (count == 0) {
+        if (done) done(context);
+        return true;
+    }
+
+    Job job = {};
+    job.type = JOB_PIXELS;
+    job.data = pixels;
+    job.len = count;
+    job.rows = 1;
+    job.done = done;
+    job.context = context;
+    return submit(job);
+}
+
+bool TransferQueue::submitPixelRows(const uint16_t* pixels, size_t width, size_t rows, size_t stride,
+                                    TransferCallback done, void* context) {
+    if (width == stride || rows == 1) {
+        return submitPixels(pixels, width * rows, done, context);
+    }
+    if (width == 0 || rows == 0) {
+        if (done) done(context);
+        return true;
+    }
+
+    Job job = {};
+    job.type = JOB_PIXELS;
+    job.data = pixels;
+    job.len = width;
+    job.rows = (uint16_t)rows;
+    job.stride = (uint16_t)stride;
+    job.done = done;
+    job.context = context;
+    return submit(job);
+}
+
+bool TransferQueue::submitFill(uint16_t color, size_t count, TransferCallback done, void* context) {
+    if (count == 0) {
+        if (done) done(context);
+        return true;
+    }
+
+    Job job = {};
+    job.type = JOB_FILL;
+    job.len = count;
+    job.color = color;
+    job.done = done;
+    job.context = context;
+    return submit(job);
+}
+
+bool TransferQueue::submitList(DisplayList& list, TransferCallback done, void* context) {
+    if (list.empty()) {
+        if (done) done(context);
+        return true;
+    }
+    if (listChained() && !compileList(list)) {
+        printf("TransferQueue: display list too long\n");
+        return false;
+    }
+
+    Job job = {};
+    job.type = JOB_LIST;
+    job.data = &list;
+    job.done = done;
+    job.context = context;
+    return submit(job);
+}
+
+void TransferQueue::writeBytes(const uint8_t* data, size_t len, bool dc) {
+    if (!_initialized || len == 0) {
+        return;
+    }
+
+    waitIdle();
+    select();
+    sendBytes(data, len, dc);
+    release();
+}
+
+bool TransferQueue::readBytes(uint8_t cmd, uint8_t* data, size_t len, uint32_t read_hz) {
+    if (!_initialized || _pio) {
+        return false;
+    }
+
+    waitIdle();
+    select();
+    sendBytes(&cmd, 1, false);
+    setDc(true);
+    waitSpiIdle();  // Drop what came in while the command went out
+
+    uint32_t write_hz = spi_get_baudrate(_spi);
+    spi_set_baudrate(_spi, read_hz);
+    spi_read_blocking(_spi, 0x00, data, len);
+    spi_set_baudrate(_spi, write_hz);
+    release();
+    return true;
+}
+
+uint32_t TransferQueue::setSpiBaud(uint32_t baud_hz) {
+    if (!_initialized || _pio) {
+        return 0;
+    }
+    waitIdle();
+    return spi_set_baudrate(_spi, baud_hz);
+}
+
+bool TransferQueue::submit(const Job& job) {
+    if (!_initialized) {
+        return false;
+    }
+
+    if (_dma_channel < 0) {
+        runBlocking(job);
+        return true;
+    }
+
+    // Wait for a free slot
+    while (_head - _tail >= QUEUE_DEPTH) {
+        tight_loop_contents();
+    }
+    _jobs[_head % QUEUE_DEPTH] = job;
+
+    // The IRQ may be draining the queue right now, so publish the job and
+    // check for idle in one step
+    uint32_t irq_state = save_and_disable_interrupts();
+    _head = _head + 1;
+    if (!_busy) {
+        _busy = true;
+        select();
+        advance();
+    }
+    restore_interrupts(irq_state);
+    return true;
+}
+
+void TransferQueue::runBlocking(const Job& job) {
+    select();
+
+    switch (job.type) {
+        case JOB_COMMAND:
+            runCommand(job);
+            break;
+        case JOB_DATA:
+            sendBytes((const uint8_t*)job.data, job.len, true);
+            break;
+        case JOB_PIXELS:
+            for (size_t row = 0; row < job.rows; row++) {
+                sendPixels((const uint16_t*)job.data + row * job.stride, job.len);
+            }
+            break;
+        case JOB_FILL:
+            sendPixelRepeat(job.color, job.len);
+            break;
+        case JOB_LIST: {
+            const DisplayList& list = *(const DisplayList*)job.data;
+            for (size_t i = 0; i < list._count; i++) {
+                const DisplayList::Op& op = list._ops[i];
+                if (op.pixels) {
+                    sendPixels(op.pixels, op.count);
+                } else {
+                    sendBytes(&op.cmd, 1, false);
+                    if (op.param_len > 0) {
+                        sendBytes(op.params, op.param_len, true);
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    release();
+    if (job.done) {
+        job.done(job.context);
+    }
+}
+
+void TransferQueue::runCommand(const Job& job) {
+    sendBytes(&job.cmd, 1, false);
+    if (job.param_len > 0) {
+        sendBytes(job.params, job.param_len, true);
+    }
+}
+
+// Start queued jobs until one needs DMA or the queue is empty.
+// Runs from submit (interrupts off) or from the DMA interrupt.
+void TransferQueue::advance() {
+    while (_tail != _head) {
+        const Job& job = _jobs[_tail % QUEUE_DEPTH];
+
+        if (job.type == JOB_COMMAND) {
+            // A few bytes: cheaper to send directly than to set up DMA
+            runCommand(job);
+            _tail = _tail + 1;
+            continue;
+        }
+
+        if (job.type == JOB_LIST) {
+            DisplayList& list = *(DisplayList*)job.data;
+            if (listChained()) {
+                // Runs to the null block at the end, which raises the IRQ
+                dma_channel_set_read_addr(_ctrl_channel, list._blocks, true);
+                return;
+            }
+            _list_pos = 0;
+            if (stepList(list)) {
+                return;
+            }
+            finishJob();
+            continue;
+        }
+
+        if (job.type == JOB_FILL) {
+            if (job.len <= INLINE_FILL) {
+                // A pixel or two for drawPixel and text: not worth an IRQ
+                sendPixelRepeat(job.color, job.len);
+                finishJob();
+                continue;
+            }
+            // The slot stays put until the job finishes, so the DMA can
+            // read the colour from it over and over
+            startDma(&job.color, job.len, 16, job.len, false);
+            return;
+        }
+
+        // Pixels go one halfword per pixel, straight from the caller's buffer
+        if (job.type == JOB_PIXELS) {
+            // Rows after the first are restarted from the IRQ (onDmaComplete)
+            _row_pos = 0;
+            startDma(job.data, job.len, 16, job.len * job.rows);
+            return;
+        }
+        startDma(job.data, job.len, 8, job.len);
+        return;
+    }
+
+    // Queue drained: release the panel
+    release();
+    _busy = false;
+}
+
+void TransferQueue::onDmaComplete() {
+    const Job& job = _jobs[_tail % QUEUE_DEPTH];
+    if (job.type == JOB_LIST && !listChained() && stepList(*(const DisplayList*)job.data)) {
+        return;
+    }
+    if (job.type == JOB_PIXELS && ++_row_pos < job.rows) {
+        // Same frame size, DC and (on PIO) packet as the first row
+        dma_channel_transfer_from_buffer_now(_dma_channel,
+            (const uint16_t*)job.data + _row_pos * job.stride, job.len);
+        return;
+    }
+    finishJob();
+    advance();
+}
+
+void TransferQueue::finishJob() {
+    const Job& job = _jobs[_tail % QUEUE_DEPTH];
+    TransferCallback done = job.done;
+    void* context = job.context;
+    _tail = _tail + 1;
+    if (done) {
+        done(context);
+    }
+}
+
+// Build the control blocks for a list on the PIO bus: command ops become
+// lcd_spi packets in the list's word area, each pixel op a 16-bit block
+// read straight from its buffer. Consecutive packets share one block.
+bool TransferQueue::compileList(DisplayList& list) {
+    dma_channel_config config = _dma_config;
+    channel_config_set_chain_to(&config, _ctrl_channel);
+    channel_config_set_irq_quiet(&config, true);   // IRQ only on the null block
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    uint32_t ctrl_words = channel_config_get_ctrl_value(&config);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    uint32_t ctrl_pixels = channel_config_get_ctrl_value(&config);
+
+    uint32_t* words = list._words;
+    size_t used = 0;
+    size_t start = 0;       // First word not yet covered by a block
+    size_t blocks = 0;
+
+    for (size_t i = 0; i < list._count; i++) {
+        const DisplayList::Op& op = list._ops[i];
+        size_t needed = op.pixels ? 1 : 2 + (op.param_len > 0 ? 1 + op.param_len : 0);
+        if (used + needed > DisplayList::MAX_WORDS) {
+            return false;
+        }
+
+        if (!op.pixels) {
+            words[used++] = lcd_spi_header(false, 8, 1);
+            words[used++] = byteWord(op.cmd);
+            if (op.param_len > 0) {
+                words[used++] = lcd_spi_header(true, 8, op.param_len);
+                for (size_t j = 0; j < op.param_len; j++) {
+                    words[used++] = byteWord(op.params[j]);
+                }
+            }
+            continue;
+        }
+
+        words[used++] = lcd_spi_header(true, 16, op.count);
+        list._blocks[blocks++] = {ctrl_words, &words[start], _dma_dest, (uint32_t)(used - start)};
+        list._blocks[blocks++] = {ctrl_pixels, op.pixels, _dma_dest, op.count};
+        start = used;
+    }
+
+    if (used > start) {
+        list._blocks[blocks++] = {ctrl_words, &words[start], _dma_dest, (uint32_t)(used - start)};
+    }
+    // Null trigger: stops the chain
+    list._blocks[blocks] = {ctrl_words, nullptr, nullptr, 0};
+    return true;
+}
+
+// Walk a list from the IRQ: send commands directly and start DMA for the
+// next pixel op. Returns false once the list is done.
+bool TransferQueue::stepList(const DisplayList& list) {
+    while (_list_pos < list._count) {
+        const DisplayList::Op& op = list._ops[_list_pos++];
+        if (op.pixels) {
+            startDma(op.pixels, op.count, 16, op.count);
+            return true;
+        }
+        sendBytes(&op.cmd, 1, false);
+        if (op.param_len > 0) {
+            sendBytes(op.params, op.param_len, true);
+        }
+    }
+    return false;
+}
+
+void TransferQueue::select() {
+    if (!_pio) {
+        gpio_put(_pin_cs, 0);
+    }
+    // The PIO program lowers CS for each packet itself
+}
+
+void TransferQueue::release() {
+    if (_pio) {
+        waitPioIdle();
+        return;
+    }
+    // Back in 8-bit mode for the next command
+    setFrameBits(8);
+    waitSpiIdle();
+    gpio_put(_pin_cs, 1);
+}
+
+void TransferQueue::sendBytes(const uint8_t* data, size_t len, bool dc) {
+    if (_pio) {
+        pio_sm_put_blocking(_pio, _pio_sm, lcd_spi_header(dc, 8, len));
+        for (size_t i = 0; i < len; i++) {
+            pio_sm_put_blocking(_pio, _pio_sm, byteWord(data[i]));
+        }
+        return;
+    }
+    setFrameBits(8);
+    setDc(dc);
+    spi_write_blocking(_spi, data, len);
+}
+
+void TransferQueue::sendPixels(const uint16_t* pixels, size_t count) {
+    if (_pio) {
+        pio_sm_put_blocking(_pio, _pio_sm, lcd_spi_header(true, 16, count));
+        for (size_t i = 0; i < count; i++) {
+            pio_sm_put_blocking(_pio, _pio_sm, (uint32_t)pixels[i] << 16);
+        }
+        return;
+    }
+    setFrameBits(16);
+    setDc(true);
+    spi_write16_blocking(_spi, pixels, count);
+}
+
+void TransferQueue::sendPixelRepeat(uint16_t color, size_t count) {
+    if (_pio) {
+        pio_sm_put_blocking(_pio, _pio_sm, lcd_spi_header(true, 16, count));
+        while (count-- > 0) {
+            pio_sm_put_blocking(_pio, _pio_sm, (uint32_t)color << 16);
+        }
+        return;
+    }
+    setFrameBits(16);
+    setDc(true);
+    spi_hw_t* hw = spi_get_hw(_spi);
+    while (count-- > 0) {
+        while (!spi_is_writable(_spi)) {
+            tight_loop_contents();
+        }
+        hw->dr = color;
+    }
+}
+
+void TransferQueue::startDma(const void* src, size_t count, uint8_t bits, size_t packet_count,
+                             bool read_increment) {
+    if (_pio) {
+        // Narrow DMA writes fill the FIFO word left-justified, as the
+        // program expects
+        pio_sm_put_blocking(_pio, _pio_sm, lcd_spi_header(true, bits, packet_count));
+    } else {
+        setFrameBits(bits);
+        setDc(true);
+    }
+    // Local copy: display lists are compiled from _dma_config
+    dma_channel_config config = _dma_config;
+    channel_config_set_transfer_data_size(&config, (bits == 16) ? DMA_SIZE_16 : DMA_SIZE_8);
+    channel_config_set_read_increment(&config, read_increment);
+    dma_channel_configure(_dma_channel, &config, _dma_dest, src, count, true);
+}
+
+void TransferQueue::setDc(bool data) {
+    if (gpio_get_out_level(_pin_dc) == data) {
+        return;
+    }
+    // DC is sampled with the last bit of each byte, so let the FIFO drain
+    waitSpiIdle();
+    gpio_put(_pin_dc, data);
+}
+
+void TransferQueue::setFrameBits(uint8_t bits) {
+    if (_frame_bits == bits) {
+        return;
+    }
+    // Only the data size changes; clock polarity stays as the HAL set it
+    waitSpiIdle();
+    hw_write_masked(&spi_get_hw(_spi)->cr0, (uint32_t)(bits - 1) << SPI_SSPCR0_DSS_LSB,
+                    SPI_SSPCR0_DSS_BITS);
+    _frame_bits = bits;
+}
+
+void TransferQueue::waitSpiIdle() {
+    while (spi_is_busy(_spi)) {
+        tight_loop_contents();
+    }
+    // DMA writes leave the RX FIFO full of clocked-in frames
+    while (spi_is_readable(_spi)) {
+        (void)spi_get_hw(_spi)->dr;
+    }
+    spi_get_hw(_spi)->icr = SPI_SSPICR_RORIC_BITS;
+}
+
+void TransferQueue::waitPioIdle() {
+    // Everything is in the FIFO by now, so the next stall is the program
+    // waiting for a header with CS raised
+    uint32_t stall = 1u << (PIO_FDEBUG_TXSTALL_LSB + _pio_sm);
+    _pio->fdebug = stall;
+    while (!(_pio->fdebug & stall)) {
+        tight_loop_contents();
+    }
+}
+
+bool TransferQueue::waitIdle(uint32_t timeout_ms) {
+    uint32_t start = to_ms_since_boot(get_absolute_time());
+    while (_busy) {
+        if (to_ms_since_boot(get_absolute_time()) - start > timeout_ms) {
+            printf("TransferQueue: timeout, aborting\n");
+            abort();
+            return false;
+        }
+        tight_loop_contents();
+    }
+    return true;
+}
+
+void TransferQueue::abort() {
+    uint32_t irq_state = save_and_disable_interrupts();
+    if (_ctrl_channel >= 0) {
+        dma_channel_abort(_ctrl_channel);
+    }
+    if (_dma_channel >= 0) {
+        DmaChannels::abort(_dma_channel);
+    }
+    _tail = _head;
+    if (_busy) {
+        if (_pio) {
+            // Drop the partial packet and go back to waiting for a header
+            pio_sm_set_enabled(_pio, _pio_sm, false);
+            pio_sm_clear_fifos(_pio, _pio_sm);
+            pio_sm_restart(_pio, _pio_sm);
+            pio_sm_exec(_pio, _pio_sm, pio_encode_jmp(_pio_offset));
+            pio_sm_set_enabled(_pio, _pio_sm, true);
+        } else {
+            release();
+        }
+        _busy = false;
+    }
+    restore_interrupts(irq_state);
+}
+
+} // namespace displays
@@ -1,7 +1,10 @@
-#include <cstdint>
+#include "displays/dcs/dcs_gfx.hpp"
+
+namespace displays {
+namespace dcs {
 
 // Standard 5x7 font data (ASCII space to ~)
-extern const unsigned char font[] = {
+const unsigned char font[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, // Space   
     0x00, 0x00, 0x5F, 0x00, 0x00, // ! 
     0x00, 0x07, 0x00, 0x07, 0x00, // " 
@@ -98,4 +101,7 @@ extern const unsigned char font[] = {
     0x00, 0x41, 0x36, 0x08, 0x00, // } 
     0x08, 0x08, 0x2A, 0x1C, 0x08, // -> 
     0x08, 0x1C, 0x2A, 0x08, 0x08  // <- 
-}; 
\ No newline at end of file
+};
+
+} // namespace dcs
+} // namespace displays
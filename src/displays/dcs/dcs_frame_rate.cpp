@@ -0,0 +1,76 @@
+#include "displays/dcs/dcs_frame_rate.hpp"
+
+namespace displays {
+namespace dcs {
+
+static uint32_t lineClocks(const FrameRateModel& model, uint8_t rtna) {
+    return model.clocks_base + model.clocks_step * rtna;
+}
+
+// Settings this close to the best are equal; the one with the shortest
+// porch wins, leaving the panel more of the period to scan (and the TE
+// presenter more room). 2 us is a one-frame slip every ~2 minutes.
+static const uint32_t TOLERANCE_NS = 2000;
+
+// Nearest setting with this line period
+static FrameRateSetting nearestPorch(const FrameRateModel& model, uint32_t osc_hz, uint16_t lines,
+                                     uint32_t target_period_ns, uint8_t rtna) {
+    uint64_t clocks = lineClocks(model, rtna);
+    uint64_t total = ((uint64_t)target_period_ns * osc_hz / 1000000000ull + clocks / 2) / clocks;
+    uint32_t porch = (total > lines) ? (uint32_t)(total - lines) : 0;
+    if (porch < model.porch_min * 2u) porch = model.porch_min * 2u;
+    if (porch > model.porch_max * 2u) porch = model.porch_max * 2u;
+
+    FrameRateSetting setting;
+    setting.rtna = rtna;
+    setting.front_porch = (uint8_t)(porch / 2);
+    setting.back_porch = (uint8_t)(porch - porch / 2);
+    setting.period_ns = (uint32_t)(clocks * (lines + porch) * 1000000000ull / osc_hz);
+    return setting;
+}
+
+static uint32_t periodError(const FrameRateSetting& setting, uint32_t target_period_ns) {
+    return (setting.period_ns > target_period_ns) ? setting.period_ns - target_period_ns
+                                                  : target_period_ns - setting.period_ns;
+}
+
+bool pickFrameRate(const FrameRateModel& model, uint32_t osc_hz, uint16_t lines,
+                   uint32_t target_period_ns, FrameRateSetting& setting) {
+    if (osc_hz == 0 || target_period_ns == 0 || lineClocks(model, model.rtna_min) == 0) {
+        return false;
+    }
+
+    uint32_t best_error = UINT32_MAX;
+    for (uint32_t rtna = model.rtna_min; rtna <= model.rtna_max; rtna++) {
+        uint32_t error = periodError(nearestPorch(model, osc_hz, lines, target_period_ns, rtna), target_period_ns);
+        if (error < best_error) {
+            best_error = error;
+        }
+    }
+
+    bool found = false;
+    for (uint32_t rtna = model.rtna_min; rtna <= model.rtna_max; rtna++) {
+        FrameRateSetting candidate = nearestPorch(model, osc_hz, lines, target_period_ns, rtna);
+        if (periodError(candidate, target_period_ns) > best_error + TOLERANCE_NS) {
+            continue;
+        }
+        if (!found || candidate.front_porch + candidate.back_porch < setting.front_porch + setting.back_porch) {
+            setting = candidate;
+            found = true;
+        }
+    }
+    return found;
+}
+
+uint32_t frameRateOscillator(const FrameRateModel& model, uint16_t lines,
+                             const FrameRateSetting& setting, uint32_t measured_period_ns) {
+    if (measured_period_ns == 0) {
+        return model.osc_hz;
+    }
+    uint64_t clocks = (uint64_t)lineClocks(model, setting.rtna) *
+                      (lines + setting.front_porch + setting.back_porch);
+    return (uint32_t)(clocks * 1000000000ull / measured_period_ns);
+}
+
+} // namespace dcs
+} // namespace displays
@@ -0,0 +1,300 @@
+#include "displays/dcs/dcs_gfx.hpp"
+#include <cstdlib>
+#include <utility>
+
+namespace displays {
+namespace dcs {
+
+Graphics::Graphics(HAL& hal) : _hal(hal) {
+}
+
+// Draw a single pixel
+void Graphics::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= _hal.getConfig().width || y >= _hal.getConfig().height) {
+        return;
+    }
+
+    _hal.setAddrWindow(x, y, x, y);
+
+    // Sent as one 16-bit SPI frame
+    _hal.fillPixels(color, 1);
+}
+
+// Draw a line
+void Graphics::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    // Straight lines are one filled rectangle
+    if (x0 == x1) {
+        if (y0 > y1) std::swap(y0, y1);
+        fillRect(x0, y0, 1, y1 - y0 + 1, color);
+        return;
+    }
+    if (y0 == y1) {
+        if (x0 > x1) std::swap(x0, x1);
+        fillRect(x0, y0, x1 - x0 + 1, 1, color);
+        return;
+    }
+
+    // Use Bresenham's algorithm to draw line
+    int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+
+    for (; x0 <= x1; x0++) {
+        if (steep) {
+            drawPixel(y0, x0, color);
+        } else {
+            drawPixel(x0, y0, color);
+        }
+
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+// Draw rectangle outline
+void Graphics::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawLine(x, y, x + w - 1, y, color);                 // Top edge
+    drawLine(x, y + h - 1, x + w - 1, y + h - 1, color); // Bottom edge
+    drawLine(x, y, x, y + h - 1, color);                 // Left edge
+    drawLine(x + w - 1, y, x + w - 1, y + h - 1, color); // Right edge
+}
+
+// Fill rectangle, false if nothing is on screen
+bool Graphics::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    int16_t x1 = x + w - 1;
+    int16_t y1 = y + h - 1;
+
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 >= _hal.getConfig().width) x1 = _hal.getConfig().width - 1;
+    if (y1 >= _hal.getConfig().height) y1 = _hal.getConfig().height - 1;
+
+    if (x1 < x || y1 < y) {
+        return false;
+    }
+
+    _hal.setAddrWindow(x, y, x1, y1);
+
+    // Whole rectangle as one DMA transfer repeating the colour
+    return _hal.fillPixels(color, (size_t)(x1 - x + 1) * (y1 - y + 1));
+}
+
+// Draw circle
+void Graphics::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    // Use Bresenham's circle algorithm
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+
+    drawPixel(x0, y0 + r, color);
+    drawPixel(x0, y0 - r, color);
+    drawPixel(x0 + r, y0, color);
+    drawPixel(x0 - r, y0, color);
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        drawPixel(x0 + x, y0 + y, color);
+        drawPixel(x0 - x, y0 + y, color);
+        drawPixel(x0 + x, y0 - y, color);
+        drawPixel(x0 - x, y0 - y, color);
+        drawPixel(x0 + y, y0 + x, color);
+        drawPixel(x0 - y, y0 + x, color);
+        drawPixel(x0 + y, y0 - x, color);
+        drawPixel(x0 - y, y0 - x, color);
+    }
+}
+
+// Fill circle
+void Graphics::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    // Vertical spans, each one rectangle
+    drawLine(x0, y0 - r, x0, y0 + r, color);
+
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        drawLine(x0 + x, y0 - y, x0 + x, y0 + y, color);
+        drawLine(x0 - x, y0 - y, x0 - x, y0 + y, color);
+        drawLine(x0 + y, y0 - x, x0 + y, y0 + x, color);
+        drawLine(x0 - y, y0 - x, x0 - y, y0 + x, color);
+    }
+}
+
+// Draw triangle
+void Graphics::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    drawLine(x0, y0, x1, y1, color);
+    drawLine(x1, y1, x2, y2, color);
+    drawLine(x2, y2, x0, y0, color);
+}
+
+void Graphics::fillScreen(uint16_t color) {
+    fillRect(0, 0, _hal.getConfig().width, _hal.getConfig().height, color);
+}
+
+// Draw character
+void Graphics::drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if ((x >= _hal.getConfig().width) ||   // Beyond right boundary
+        (y >= _hal.getConfig().height) ||  // Beyond bottom boundary
+        ((x + 6 * size - 1) < 0) ||        // Beyond left boundary
+        ((y + 8 * size - 1) < 0))          // Beyond top boundary
+        return;
+
+    // Ensure character is in printable range
+    if (c < ' ' || c > '~')
+        c = '?';
+
+    for (int8_t i = 0; i < 6; i++) {
+        uint8_t line = (i == 5) ? 0x0 : font[(c - ' ') * 5 + i];
+
+        for (int8_t j = 0; j < 8; j++) {
+            if (line & 0x1) {
+                fillRect(x + i * size, y + j * size, size, size, color);
+            } else if (bg != color) {
+                fillRect(x + i * size, y + j * size, size, size, bg);
+            }
+            line >>= 1;
+        }
+    }
+}
+
+// Draw string
+void Graphics::drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    int16_t cursor_x = x;
+    int16_t cursor_y = y;
+
+    while (*str) {
+        if (*str == '\n') {
+            cursor_x = x;
+            cursor_y += 8 * size;
+        } else if (*str == '\r') {
+            cursor_x = x;
+        } else {
+            drawChar(cursor_x, cursor_y, *str, color, bg, size);
+            cursor_x += 6 * size;
+
+            // If about to exceed right boundary, auto line break
+            if (cursor_x > (_hal.getConfig().width - 6 * size)) {
+                cursor_x = x;
+                cursor_y += 8 * size;
+            }
+        }
+        str++;
+    }
+}
+
+// Draw image
+bool Graphics::drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) {
+    if (w <= 0) {
+        return false;
+    }
+    const displays::ImageRegion region = {x, y, w, h, data, (uint16_t)w};
+    return drawRegion(region);
+}
+
+bool Graphics::drawImageRegions(const displays::ImageRegion* regions, size_t count) {
+    if (!regions) {
+        return false;
+    }
+
+    // Every region is queued before the first has gone out, so the queue
+    // runs them back to back with CS held low
+    bool ok = true;
+    for (size_t i = 0; i < count; i++) {
+        if (!drawRegion(regions[i])) {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool Graphics::drawRegion(const displays::ImageRegion& region) {
+    int16_t x = region.x;
+    int16_t y = region.y;
+    int16_t w = region.w;
+    int16_t h = region.h;
+    if (!region.pixels || w <= 0 || h <= 0 || region.stride < w ||
+        x >= _hal.getConfig().width || y >= _hal.getConfig().height) {
+        return false;
+    }
+
+    const int16_t src_x = (x < 0) ? -x : 0;  // First visible source column/row
+    const int16_t src_y = (y < 0) ? -y : 0;
+
+    // Clip coordinates
+    int16_t x1 = x + w - 1;
+    int16_t y1 = y + h - 1;
+
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 >= _hal.getConfig().width) x1 = _hal.getConfig().width - 1;
+    if (y1 >= _hal.getConfig().height) y1 = _hal.getConfig().height - 1;
+
+    w = x1 - x + 1;
+    h = y1 - y + 1;
+
+    if (w <= 0 || h <= 0) {
+        return false;
+    }
+
+    _hal.setAddrWindow(x, y, x1, y1);
+
+    // Pixels go out as 16-bit frames straight from the source; a clipped
+    // or strided rectangle is still one job, restarted on each row
+    const uint16_t* src = region.pixels + src_y * region.stride + src_x;
+    return _hal.writePixelRows(src, w, h, region.stride);
+}
+
+bool Graphics::drawImageRGB444(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* data) {
+    // Packed data can't be clipped, so the rectangle must fit on screen
+    if (!data || w <= 0 || h <= 0 || x < 0 || y < 0 ||
+        x + w > _hal.getConfig().width || y + h > _hal.getConfig().height ||
+        ((w * h) & 1)) {
+        return false;
+    }
+
+    _hal.setAddrWindow(x, y, x + w - 1, y + h - 1, PIXEL_FORMAT_RGB444);
+    return _hal.writeBytesDma(data, (size_t)w * h * 3 / 2);
+}
+
+} // namespace dcs
+} // namespace displays
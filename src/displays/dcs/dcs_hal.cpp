@@ -0,0 +1,351 @@
+#include "displays/dcs/dcs_hal.hpp"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "pico/stdlib.h"
+#include "flash_settings.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace displays {
+namespace dcs {
+
+HAL::HAL() :
+    _initialized(false),
+    _pixel_format(PIXEL_FORMAT_RGB565),
+    _x_offset(0),
+    _y_offset(0),
+    _dma_enabled(false),
+    _reset_time(nil_time) {
+}
+
+HAL::~HAL() {
+    _queue.deinit();
+}
+
+bool HAL::init(const Config& config) {
+    if (_initialized) {
+        return true;
+    }
+
+    _config = config;
+
+    if (_config.bus_width == 0) {
+        // Initialize SPI (8 bits, SPI mode 0)
+        uint actual_baud = spi_init(_config.spi_inst, _config.spi_speed_hz);
+        printf("SPI initialized at %u Hz (requested %u Hz)\n", actual_baud, (unsigned)_config.spi_speed_hz);
+        spi_set_format(_config.spi_inst, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+        gpio_set_function(_config.pin_din, GPIO_FUNC_SPI);
+        gpio_set_function(_config.pin_sck, GPIO_FUNC_SPI);
+        if (_config.pin_miso >= 0) {
+            gpio_set_function(_config.pin_miso, GPIO_FUNC_SPI);
+        }
+    }
+
+    // Control pins
+    gpio_init(_config.pin_cs);
+    gpio_init(_config.pin_dc);
+    gpio_init(_config.pin_reset);
+    gpio_set_dir(_config.pin_cs, GPIO_OUT);
+    gpio_set_dir(_config.pin_dc, GPIO_OUT);
+    gpio_set_dir(_config.pin_reset, GPIO_OUT);
+    gpio_put(_config.pin_cs, 1);     // Not selected
+    gpio_put(_config.pin_dc, 1);     // Data mode
+    gpio_put(_config.pin_reset, 1);  // Not reset
+
+    // Backlight on PWM for brightness control, off until the panel is ready
+    gpio_init(_config.pin_bl);
+    gpio_set_function(_config.pin_bl, GPIO_FUNC_PWM);
+    uint slice_num = pwm_gpio_to_slice_num(_config.pin_bl);
+    pwm_set_wrap(slice_num, 255);  // 8-bit resolution (0-255)
+    pwm_set_chan_level(slice_num, pwm_gpio_to_channel(_config.pin_bl), 0);
+    pwm_set_enabled(slice_num, true);
+
+    // Transfer queue, on DMA if enabled
+    if (!_queue.init(_config.spi_inst, _config.pin_cs, _config.pin_dc, _config.dma.enabled)) {
+        return false;
+    }
+    if (_config.bus_width != 0) {
+        // No SPI wiring to fall back to
+        if (!_queue.useParallelBus(_config.pin_wr, _config.pin_d0, _config.bus_width,
+                                   _config.bus_write_hz)) {
+            _queue.deinit();
+            return false;
+        }
+    } else if (_config.pio_bus) {
+        // Falls back to the SPI block if the pins or PIO resources don't allow it
+        _queue.usePioBus(_config.pin_sck, _config.pin_din, _config.spi_speed_hz);
+    }
+    _dma_enabled = _queue.isDmaEnabled();
+
+    _initialized = true;
+    return true;
+}
+
+void HAL::writeCommand(uint8_t cmd, const uint8_t* params, size_t len) {
+    if (len <= displays::TransferQueue::MAX_PARAMS) {
+        // Command and parameters in one CS frame
+        _queue.submitCommand(cmd, params, len);
+        _queue.waitIdle();
+        return;
+    }
+    _queue.writeBytes(&cmd, 1, false);
+    _queue.writeBytes(params, len, true);
+}
+
+void HAL::writeDataBulk(const uint8_t* data, size_t len) {
+    _queue.writeBytes(data, len, true);
+}
+
+void HAL::runInitTable(const InitCommand* table, size_t count) {
+    // Entries are queued back to back in one CS frame; the CPU only
+    // waits for the queue where the panel needs time after a command
+    for (size_t i = 0; i < count; i++) {
+        if (table[i].cmd == DCS_SLPOUT) {
+            // No SLPOUT within 120 ms of a reset (ILI9341/ST7789/ST7796)
+            _queue.waitIdle();
+            sleep_until(delayed_by_ms(_reset_time, 120));
+        }
+        _queue.submitCommand(table[i].cmd, table[i].params, table[i].len);
+        if (table[i].delay_ms > 0) {
+            _queue.waitIdle();
+            delay(table[i].delay_ms);
+        }
+        if (table[i].cmd == DCS_COLMOD && table[i].len == 1) {
+            _pixel_format = (PixelFormat)table[i].params[0];
+        }
+    }
+    _queue.waitIdle();
+}
+
+void HAL::queueCommand(uint8_t cmd, const uint8_t* params, size_t len) {
+    _queue.submitCommand(cmd, params, len);
+}
+
+bool HAL::writeDataDma(const uint16_t* data, size_t len) {
+    // Sent as 16-bit SPI frames straight from data, no copy
+    return _queue.submitPixels(data, len);
+}
+
+bool HAL::writeBytesDma(const uint8_t* data, size_t len) {
+    // Sent as 8-bit SPI frames straight from data, no copy
+    return _queue.submitData(data, len);
+}
+
+bool HAL::fillPixels(uint16_t color, size_t count) {
+    // The colour is copied into the queue, nothing to keep valid
+    return _queue.submitFill(color, count);
+}
+
+bool HAL::writePixelRows(const uint16_t* data, size_t width, size_t rows, size_t stride,
+                         displays::TransferCallback done, void* context) {
+    // One RAMWR burst read row by row from a wider buffer
+    return _queue.submitPixelRows(data, width, rows, stride, done, context);
+}
+
+uint32_t HAL::pixelTimePs() const {
+    if (_config.bus_width != 0) {
+        // The state machine runs at twice the WR rate and takes 5 clocks
+        // per pixel on the 8-bit bus, 3 on the 16-bit bus
+        uint32_t clocks = (_config.bus_width == 16) ? 3 : 5;
+        return (uint32_t)(clocks * 500000000000ull / _config.bus_write_hz);
+    }
+    return (uint32_t)(16ull * 1000000000000ull / _config.spi_speed_hz);
+}
+
+// Panel reads are specified at about 150 ns per bit (ILI9341, ST7789)
+static const uint32_t READ_HZ = 6 * 1000 * 1000;
+static const size_t TUNE_PIXELS = 64;
+static const int MAX_TUNE_STEPS = 6;
+// The rate found depends on the bus code too: a rebuild retunes
+static const char BUILD_ID[] = __DATE__ " " __TIME__;
+
+uint32_t HAL::tuneSpiClock(const char* name) {
+    if (!_initialized || _config.pin_miso < 0 || _config.spi_max_hz <= _config.spi_speed_hz ||
+        _config.bus_width != 0 || _queue.isPioBus()) {
+        return _config.spi_speed_hz;
+    }
+
+    // Anything the result depends on: a change retunes
+    uint32_t key = FlashSettings::hash(name, strlen(name));
+    uint32_t wiring[6] = {spi_get_index(_config.spi_inst), _config.pin_din, _config.pin_sck,
+                          (uint32_t)_config.pin_miso, _config.spi_max_hz, clock_get_hz(clk_peri)};
+    key = FlashSettings::hash(wiring, sizeof(wiring), key);
+    key = FlashSettings::hash(&_config.spi_speed_hz, sizeof(_config.spi_speed_hz), key);
+    key = FlashSettings::hash(BUILD_ID, sizeof(BUILD_ID) - 1, key);
+
+    uint32_t saved_hz;
+    if (FlashSettings::load(key, &saved_hz, sizeof(saved_hz))) {
+        _config.spi_speed_hz = _queue.setSpiBaud(saved_hz);
+        printf("%s: SPI at %lu Hz (tuned earlier)\n", name, (unsigned long)_config.spi_speed_hz);
+        return _config.spi_speed_hz;
+    }
+
+    // Each achievable rate from the top down to the configured one; the
+    // configured rate stays if none reads back
+    uint32_t best_hz = _queue.setSpiBaud(_config.spi_speed_hz);
+    uint32_t best_us = UINT32_MAX;
+    uint32_t hz = _config.spi_max_hz;
+    for (int step = 0; step < MAX_TUNE_STEPS; step++) {
+        uint32_t actual = _queue.setSpiBaud(hz);
+        if (actual < _config.spi_speed_hz) {
+            break;
+        }
+        bool ok = verifyWrite();
+        uint32_t frame_us = timeFrameUs();
+        printf("%s: SPI %lu Hz %s, frame %lu us\n", name, (unsigned long)actual,
+               ok ? "reads back" : "corrupted", (unsigned long)frame_us);
+        if (ok && frame_us < best_us) {
+            best_hz = actual;
+            best_us = frame_us;
+        }
+        hz = actual - 1;  // Next divider down
+    }
+
+    _config.spi_speed_hz = _queue.setSpiBaud(best_hz);
+    if (best_us != UINT32_MAX) {
+        FlashSettings::save(key, &_config.spi_speed_hz, sizeof(_config.spi_speed_hz));
+    }
+    printf("%s: SPI tuned to %lu Hz\n", name, (unsigned long)_config.spi_speed_hz);
+    return _config.spi_speed_hz;
+}
+
+// Write a test row at the current clock and compare what RAMRD returns
+bool HAL::verifyWrite() {
+    size_t count = (_config.width < TUNE_PIXELS) ? _config.width : TUNE_PIXELS;
+    uint16_t pixels[TUNE_PIXELS];
+    uint32_t seed = 0x2545F491;
+    for (size_t i = 0; i < count; i++) {
+        // Alternating bits first, the hardest edges, then noise
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        pixels[i] = (i < 4) ? ((i & 1) ? 0xAAAA : 0x5555) : (uint16_t)seed;
+    }
+    setAddrWindow(0, 0, count - 1, 0);
+    _queue.submitPixels(pixels, count);
+    _queue.waitIdle();
+
+    // Controllers send dummy bits first (8 on the ILI9341, 1 on the ST7789)
+    // and RGB666 bytes or RGB565, so try each bit offset in both forms
+    uint8_t raw[TUNE_PIXELS * 3 + 3];
+    size_t raw_len = count * 3 + 3;
+    if (!_queue.readBytes(DCS_RAMRD, raw, raw_len, READ_HZ)) {
+        return false;
+    }
+    for (size_t offset = 0; offset <= 16; offset++) {
+        for (int bytes_per_pixel = 3; bytes_per_pixel >= 2; bytes_per_pixel--) {
+            bool match = true;
+            for (size_t i = 0; i < count * bytes_per_pixel && match; i++) {
+                size_t bit = offset + i * 8;
+                uint8_t got = (uint8_t)((raw[bit / 8] << (bit % 8)) | (raw[bit / 8 + 1] >> (8 - bit % 8)));
+                uint16_t p = pixels[i / bytes_per_pixel];
+                uint8_t want;
+                uint8_t mask;
+                if (bytes_per_pixel == 2) {
+                    want = (i & 1) ? (uint8_t)p : (uint8_t)(p >> 8);
+                    mask = 0xFF;
+                } else {
+                    // 5/6/5 bits left-justified in each byte
+                    size_t c = i % 3;
+                    want = (c == 0) ? (p >> 8) : (c == 1) ? (p >> 3) : (p << 3);
+                    mask = (c == 1) ? 0xFC : 0xF8;
+                }
+                match = ((got ^ want) & mask) == 0;
+            }
+            if (match) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint32_t HAL::timeFrameUs() {
+    uint32_t start = time_us_32();
+    setAddrWindow(0, 0, _config.width - 1, _config.height - 1);
+    _queue.submitFill(BLACK, (size_t)_config.width * _config.height);
+    _queue.waitIdle();
+    return time_us_32() - start;
+}
+
+bool HAL::waitForDmaComplete(uint32_t timeout_ms) {
+    return _queue.waitIdle(timeout_ms);
+}
+
+void HAL::abortDma() {
+    _queue.abort();
+}
+
+void HAL::setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, PixelFormat format) {
+    // COLMOD must change before RAMWR, so switch formats here
+    if (format != _pixel_format) {
+        setPixelFormat(format);
+    }
+
+    x0 += _x_offset;
+    x1 += _x_offset;
+    y0 += _y_offset;
+    y1 += _y_offset;
+
+    // Queued behind any transfer still in flight
+    uint8_t data[4];
+
+    data[0] = x0 >> 8;
+    data[1] = x0 & 0xFF;
+    data[2] = x1 >> 8;
+    data[3] = x1 & 0xFF;
+    _queue.submitCommand(DCS_CASET, data, 4);
+
+    data[0] = y0 >> 8;
+    data[1] = y0 & 0xFF;
+    data[2] = y1 >> 8;
+    data[3] = y1 & 0xFF;
+    _queue.submitCommand(DCS_RASET, data, 4);
+
+    _queue.submitCommand(DCS_RAMWR);
+}
+
+void HAL::setPixelFormat(PixelFormat format) {
+    uint8_t data = format;
+    _queue.submitCommand(DCS_COLMOD, &data, 1);
+    _pixel_format = format;
+}
+
+void HAL::reset() {
+    // Datasheet minimums: 10 us low, then 5 ms before the first command.
+    // The 120 ms before SLPOUT is enforced by runInitTable(), so the
+    // init table goes out while the controller finishes its reset.
+    gpio_put(_config.pin_reset, 0);
+    sleep_us(20);
+    gpio_put(_config.pin_reset, 1);
+    _reset_time = get_absolute_time();
+    delay(5);
+}
+
+void HAL::setBacklight(bool on) {
+    // The pin is driven by PWM, so on/off is full or zero duty
+    setBrightness(on ? 255 : 0);
+}
+
+void HAL::setBrightness(uint8_t brightness) {
+    // Use PWM to control backlight brightness (0-255)
+    uint slice_num = pwm_gpio_to_slice_num(_config.pin_bl);
+    pwm_set_chan_level(slice_num, pwm_gpio_to_channel(_config.pin_bl), brightness);
+}
+
+void HAL::delay(uint32_t ms) {
+    sleep_ms(ms);
+}
+
+void HAL::setGeometry(Rotation rotation, uint16_t width, uint16_t height,
+                      uint16_t x_offset, uint16_t y_offset) {
+    _config.rotation = rotation;
+    _config.width = width;
+    _config.height = height;
+    _x_offset = x_offset;
+    _y_offset = y_offset;
+}
+
+} // namespace dcs
+} // namespace displays
@@ -0,0 +1,264 @@
+#include "displays/dcs/dcs_presenter.hpp"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+#include <cstdio>
+
+namespace displays {
+namespace dcs {
+
+// Presenter listening on each GPIO, for the shared interrupt handler
+static TePresenter* s_presenters[NUM_BANK0_GPIOS];
+
+// Queue a band no closer than this to its start time
+static const uint64_t ALARM_LEAD_NS = 50 * 1000;
+
+// Queue jobs per band: COLMOD if the format changes, CASET, RASET, RAMWR
+// and the pixel rows
+static const size_t BAND_JOBS = 5;
+
+// Longest gap taken as a first TE period (10 Hz); longer ones are stalls
+static const uint64_t MAX_TE_PERIOD_NS = 100 * 1000 * 1000;
+
+// Retry delay for a band that finds the queue full
+static const int64_t QUEUE_RETRY_US = 20;
+
+void te_irq_handler() {
+    for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+        if (s_presenters[pin] && (gpio_get_irq_event_mask(pin) & GPIO_IRQ_EDGE_RISE)) {
+            gpio_acknowledge_irq(pin, GPIO_IRQ_EDGE_RISE);
+            s_presenters[pin]->onTe();
+        }
+    }
+}
+
+int64_t te_band_alarm(alarm_id_t id, void* user_data) {
+    return ((TePresenter*)user_data)->onAlarm();
+}
+
+void te_band_done(void* context) {
+    ((TePresenter*)context)->onBandDone();
+}
+
+TePresenter::TePresenter(HAL& hal) :
+    _hal(hal),
+    _pin_te(-1),
+    _te_us(0),
+    _period_ns(0),
+    _lines(0),
+    _blank_lines(0),
+    _scan_x(false),
+    _reversed(false),
+    _x(0), _y(0), _w(0), _h(0),
+    _data(nullptr),
+    _band_count(0),
+    _band_pos(0),
+    _band_done(0),
+    _pending(false),
+    _tear_free(true),
+    _pixel_ps(0),
+    _bus_free_us(0) {
+}
+
+TePresenter::~TePresenter() {
+    if (_pin_te >= 0) {
+        gpio_set_irq_enabled(_pin_te, GPIO_IRQ_EDGE_RISE, false);
+        gpio_remove_raw_irq_handler(_pin_te, te_irq_handler);
+        s_presenters[_pin_te] = nullptr;
+    }
+}
+
+bool TePresenter::init(uint8_t pin_te) {
+    if (_pin_te >= 0) {
+        return true;
+    }
+    if (pin_te >= NUM_BANK0_GPIOS) {
+        return false;
+    }
+
+    gpio_init(pin_te);
+    gpio_set_dir(pin_te, GPIO_IN);
+    gpio_pull_down(pin_te);  // Reads low if TE isn't connected
+
+    _pin_te = pin_te;
+    s_presenters[pin_te] = this;
+    gpio_add_raw_irq_handler(pin_te, te_irq_handler);
+    gpio_set_irq_enabled(pin_te, GPIO_IRQ_EDGE_RISE, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
+    // From the bus clock until a band has been timed
+    _pixel_ps = _hal.pixelTimePs();
+
+    printf("TE: tear-free presentation on GPIO %d\n", pin_te);
+    return true;
+}
+
+void TePresenter::setScan(uint16_t lines, uint16_t blank_lines, uint8_t madctl) {
+    wait();
+    _lines = lines;
+    _blank_lines = blank_lines;
+    // MV puts the gate lines along screen x; MY mirrors the gate order with
+    // or without MV. ML (refresh order) is left clear by every panel.
+    _scan_x = madctl & MADCTL_MV;
+    _reversed = madctl & MADCTL_MY;
+}
+
+void TePresenter::onTe() {
+    uint64_t now = time_us_64();
+    if (_te_us != 0) {
+        // In 64 bits: after a stall or with TE re-enabled the gap can be
+        // seconds, which would wrap in 32
+        uint64_t period = (now - _te_us) * 1000;
+        if (_period_ns == 0) {
+            if (period < MAX_TE_PERIOD_NS) {
+                _period_ns = (uint32_t)period;
+            }
+        } else if (period < (uint64_t)_period_ns * 3 / 2) {
+            // Smooth out interrupt latency; skip periods with a missed edge
+            _period_ns = _period_ns - _period_ns / 8 + (uint32_t)period / 8;
+        }
+    }
+    _te_us = now;
+}
+
+bool TePresenter::presentImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) {
+    if (_pin_te < 0 || _period_ns == 0 || _lines == 0 || !data) {
+        return false;
+    }
+
+    const Config& config = _hal.getConfig();
+    if (w <= 0 || h <= 0 || x < 0 || y < 0 || x + w > config.width || y + h > config.height) {
+        return false;
+    }
+
+    // Gate lines covered by the image
+    uint16_t offset = _scan_x ? _hal.getXOffset() : _hal.getYOffset();
+    int ram0 = (_scan_x ? x : y) + offset;
+    int ram1 = ram0 + (_scan_x ? w : h);
+    if (ram1 > _lines) {
+        return false;
+    }
+    uint16_t first = _reversed ? _lines - ram1 : ram0;
+    uint16_t last = _reversed ? _lines - ram0 : ram1;
+
+    wait();
+
+    // The TE interrupt updates both, and a 64-bit read isn't atomic on the
+    // M0+: take one consistent pair
+    uint32_t saved = save_and_disable_interrupts();
+    uint64_t te_us = _te_us;
+    uint32_t period_ns = _period_ns;
+    restore_interrupts(saved);
+
+    // Strips across the scan touch all their lines until they finish, and
+    // so do rows written against it
+    BandOrder order = (_scan_x || _reversed) ? BAND_BLOCK : BAND_SEQUENTIAL;
+    uint32_t pixels_per_line = _scan_x ? h : w;
+    uint32_t write_line_ns = (uint32_t)((uint64_t)pixels_per_line * _pixel_ps / 1000);
+
+    ScanTiming scan;
+    scan.period_ns = period_ns;
+    scan.lines = _lines;
+    scan.blank_lines = _blank_lines;
+    bool tear_free = planScanBands(scan, first, last, write_line_ns, order,
+                                   _bands, MAX_BANDS, _band_count);
+    if (!tear_free && _tear_free) {
+        printf("TE: frame takes longer than the panel refresh allows, expect tearing\n");
+    }
+    _tear_free = tear_free;
+
+    // First refresh whose plan hasn't started yet
+    uint64_t now_ns = time_us_64() * 1000;
+    uint64_t te_ns = te_us * 1000;
+    while (te_ns + _bands[0].start_ns < now_ns + ALARM_LEAD_NS) {
+        te_ns += scan.period_ns;
+    }
+
+    _x = x;
+    _y = y;
+    _w = w;
+    _h = h;
+    _data = data;
+    _band_pos = 0;
+    _band_done = 0;
+    _bus_free_us = 0;
+    _pending = true;
+
+    absolute_time_t start = from_us_since_boot((te_ns + _bands[0].start_ns) / 1000);
+    if (add_alarm_at(start, te_band_alarm, this, true) < 0) {
+        _pending = false;
+        return false;
+    }
+    return true;
+}
+
+bool TePresenter::wait(uint32_t timeout_ms) {
+    absolute_time_t timeout = make_timeout_time_ms(timeout_ms);
+    while (_pending) {
+        if (absolute_time_diff_us(get_absolute_time(), timeout) <= 0) {
+            return false;
+        }
+        tight_loop_contents();
+    }
+    return true;
+}
+
+// Timer interrupt: queue the next band and reschedule for the one after
+int64_t TePresenter::onAlarm() {
+    // submit() would spin for a slot here, and the DMA interrupt that frees
+    // them can't preempt this one: try again once the bus has moved on
+    if (_hal.queueFreeSlots() < BAND_JOBS) {
+        return QUEUE_RETRY_US;
+    }
+
+    size_t i = _band_pos;
+    _band_pos = i + 1;
+    _submit_us[i] = time_us_64();
+    submitBand(_bands[i]);
+
+    if (i + 1 >= _band_count) {
+        return 0;
+    }
+    // Negative: relative to when this alarm was due, so bands don't drift
+    int64_t gap_us = (_bands[i + 1].start_ns - _bands[i].start_ns) / 1000;
+    return -(gap_us > 0 ? gap_us : 1);
+}
+
+void TePresenter::submitBand(const ScanBand& band) {
+    // Gate lines back to screen positions along the scan axis
+    uint16_t offset = _scan_x ? _hal.getXOffset() : _hal.getYOffset();
+    int p0 = _reversed ? _lines - band.last - offset : band.first - offset;
+    int p1 = _reversed ? _lines - band.first - offset : band.last - offset;
+
+    if (_scan_x) {
+        _hal.setAddrWindow(p0, _y, p1 - 1, _y + _h - 1);
+        _hal.writePixelRows(_data + (p0 - _x), p1 - p0, _h, _w, te_band_done, this);
+    } else {
+        _hal.setAddrWindow(_x, p0, _x + _w - 1, p1 - 1);
+        _hal.writePixelRows(_data + (p0 - _y) * _w, _w, p1 - p0, _w, te_band_done, this);
+    }
+}
+
+// DMA interrupt: a band has left the buffer
+void TePresenter::onBandDone() {
+    size_t i = _band_done;
+    uint64_t now = time_us_64();
+
+    // Time the band from when the bus was free for it
+    uint64_t started = (_submit_us[i] > _bus_free_us) ? _submit_us[i] : _bus_free_us;
+    uint32_t pixels = (uint32_t)(_bands[i].last - _bands[i].first) * (_scan_x ? _h : _w);
+    if (pixels > 0 && now > started) {
+        uint32_t measured = (uint32_t)((now - started) * 1000000 / pixels);
+        _pixel_ps = _pixel_ps - _pixel_ps / 4 + measured / 4;
+    }
+    _bus_free_us = now;
+
+    _band_done = i + 1;
+    if (i + 1 >= _band_count) {
+        _pending = false;
+    }
+}
+
+} // namespace dcs
+} // namespace displays
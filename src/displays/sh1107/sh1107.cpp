@@ -1,8 +1,10 @@
 #include "displays/sh1107/sh1107.hpp"
 #include "pico/stdlib.h"
 #include "displays/sh1107/sh1107_hal.hpp"
+#include "displays/sh1107/sh1107_pack.hpp"
 #include <vector>
 #include <cstring>
+#include <cstdio>
 
 using namespace sh1107;
 
@@ -10,6 +12,10 @@ SH1107::SH1107() : _initialized(false) {}
 SH1107::~SH1107() {}
 
 bool SH1107::begin(const Config& config) {
+    if (config.width > MAX_WIDTH) {
+        printf("SH1107: width %u is over the %d columns of the page buffer\n", config.width, MAX_WIDTH);
+        return false;
+    }
     bool ok = _hal.init(config);
     if (!ok) return false;
     _initialized = true;
@@ -20,7 +26,27 @@ void SH1107::setRotation(Rotation rotation) { _hal.setRotation(rotation); }
 
 // Helper: send a full frame buffer (w x h RGB565) converting to monochrome pages
 void SH1107::drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) {
-    if (!_initialized) return;
+    if (w <= 0) return;
+    const displays::ImageRegion region = {x, y, w, h, data, (uint16_t)w};
+    drawRegion(region);
+}
+
+// Regions go out one after another; each covers whole pages in y, so the
+// rows of a partly covered page outside the region are cleared
+void SH1107::drawImageRegions(const displays::ImageRegion* regions, size_t count) {
+    if (!regions) return;
+    for (size_t i = 0; i < count; ++i) {
+        drawRegion(regions[i]);
+    }
+}
+
+void SH1107::drawRegion(const displays::ImageRegion& region) {
+    if (!_initialized || !region.pixels || region.stride < region.w) return;
+
+    const int16_t x = region.x;
+    const int16_t y = region.y;
+    const int16_t w = region.w;
+    const int16_t h = region.h;
     
     const int display_width = _hal.getConfig().width;
     const int display_height = _hal.getConfig().height;
@@ -39,51 +65,13 @@ void SH1107::drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_
     // Calculate which pages we need to update
     int start_page = draw_y / 8;
     int end_page = (draw_y + draw_h - 1) / 8;
-    
-    // Static buffer to avoid memory allocations in time-critical path
-    static uint8_t pageBuf[128]; // SH1107 max width
-    
-    // Build and send pages
-    for (int page = start_page; page <= end_page; ++page) {
-        // Set page address
-        _hal.writeCommand(0xB0 | page);
-        // Set column address to start of drawing area
-        _hal.writeCommand(0x00 | (draw_x & 0x0F));        // Set lower column address
-        _hal.writeCommand(0x10 | ((draw_x >> 4) & 0x0F)); // Set higher column address
-
-        // Clear buffer
-        memset(pageBuf, 0, draw_w);
 
-        for (int col = 0; col < draw_w; ++col) {
-            uint8_t byte = 0;
-            for (int bit = 0; bit < 8; ++bit) {
-                int screen_y = page * 8 + bit;
-                int src_y = screen_y - y;
-                int src_x = (draw_x + col) - x;
-                
-                // Skip if outside source image bounds
-                if (src_x < 0 || src_x >= w || src_y < 0 || src_y >= h) continue;
-                
-                // pick pixel from input data
-                int srcIndex = src_y * w + src_x;
-                if (srcIndex >= w * h || srcIndex < 0) continue; // Additional safety check
-                
-                uint16_t pix = data[srcIndex];
-                // Optimized RGB565 to luminance conversion
-                // Extract and convert in one go with bit shifting
-                uint8_t r = (pix >> 8) & 0xF8;  // Red: take top 5 bits, shift to 8-bit range
-                uint8_t g = (pix >> 3) & 0xFC;  // Green: take top 6 bits, shift to 8-bit range  
-                uint8_t b = (pix << 3) & 0xF8;  // Blue: take top 5 bits, shift to 8-bit range
-                
-                // Fast luminance using integer approximation: Y = (R + 2*G + B) / 4
-                uint16_t lum = (r + (g << 1) + b) >> 2;
-                if (lum > 128) byte |= (1 << bit);
-            }
-            pageBuf[col] = byte;
-        }
-
-        // Send page buffer
-        _hal.writeDataBuffer(pageBuf, draw_w);
+    // Build and send pages; over I2C with DMA the next page is built
+    // while the last one goes out
+    for (int page = start_page; page <= end_page; ++page) {
+        buildPage(region, page, draw_x, draw_w, _page_buf);
+        // Page address, column address and the page buffer
+        _hal.writePage(page, draw_x, _page_buf, draw_w);
     }
 }
 
@@ -94,16 +82,10 @@ void SH1107::clearScreen(uint16_t color) {
     const int height = _hal.getConfig().height;
     const int pages = (height + 7) / 8;
     uint8_t fill = (color == 0) ? 0x00 : 0xFF;
-    
-    // Static buffer to avoid memory allocations
-    static uint8_t pageBuf[128]; // SH1107 max width
-    memset(pageBuf, fill, width);
+    memset(_page_buf, fill, width);
 
     for (int page = 0; page < pages; ++page) {
-        _hal.writeCommand(0xB0 | page);
-        _hal.writeCommand(0x00 | (0 & 0x0F));        // Set lower column address (0)
-        _hal.writeCommand(0x10 | ((0 >> 4) & 0x0F)); // Set higher column address (0)
-        _hal.writeDataBuffer(pageBuf, width);
+        _hal.writePage(page, 0, _page_buf, width);
     }
 }
 
@@ -1,11 +1,22 @@
 #include "displays/sh1107/sh1107_hal.hpp"
+#include "dma_channels.hpp"
 #include "pico/stdlib.h"
 #include <string.h>
+#include <cstdio>
 
 using namespace sh1107;
 
-HAL::HAL() : _initialized(false) {}
-HAL::~HAL() {}
+// A 136-byte page takes 1.2 ms at 1 MHz and 12 ms at 100 kHz
+static const uint32_t I2C_TIMEOUT_US = 50 * 1000;
+
+HAL::HAL() : _initialized(false), _pages_sent(0), _i2c_next(0), _i2c_busy(false), _dma_channel(-1) {}
+
+HAL::~HAL() {
+    if (_dma_channel >= 0) {
+        i2cWait();
+        DmaChannels::unclaim(_dma_channel);
+    }
+}
 
 static void spi_tx_blocking(spi_inst_t* spi, const uint8_t* buf, size_t len) {
     // Optimized: send entire buffer at once instead of byte-by-byte
@@ -22,9 +33,36 @@ void HAL::spi_init_hw() {
     gpio_init(_config.pin_reset); gpio_set_dir(_config.pin_reset, GPIO_OUT);
 }
 
+void HAL::i2c_init_hw() {
+    i2c_init(_config.i2c_inst, _config.i2c_speed_hz);
+    gpio_set_function(_config.pin_sda, GPIO_FUNC_I2C);
+    gpio_set_function(_config.pin_scl, GPIO_FUNC_I2C);
+    // Only a help: at 1 MHz the bus wants ~2k external pull-ups
+    gpio_pull_up(_config.pin_sda);
+    gpio_pull_up(_config.pin_scl);
+    gpio_init(_config.pin_reset); gpio_set_dir(_config.pin_reset, GPIO_OUT);
+
+    // One target, so the address is set here instead of on every transfer
+    i2c_hw_t* hw = i2c_get_hw(_config.i2c_inst);
+    hw->enable = 0;
+    hw->tar = _config.i2c_address;
+    hw->enable = 1;
+
+    if (_config.dma.enabled && _dma_channel < 0) {
+        _dma_channel = DmaChannels::claim();
+        if (_dma_channel < 0) {
+            printf("SH1107: no free DMA channel, I2C writes go from the CPU\n");
+        }
+    }
+}
+
 bool HAL::init(const Config& config) {
     _config = config;
-    spi_init_hw();
+    if (_config.bus == BUS_I2C) {
+        i2c_init_hw();
+    } else {
+        spi_init_hw();
+    }
     reset();
 
     // Add delay for power supply stabilization
@@ -32,28 +70,39 @@ bool HAL::init(const Config& config) {
 
     // Minimal init sequence based on SH1107 datasheet v2.1
     send_command(0xAE); // Display off
+    if (!i2cWait()) {
+        printf("SH1107: no ACK at I2C address 0x%02X\n", _config.i2c_address);
+        return false;
+    }
     sleep_ms(10); // Allow command processing
     
-    send_command(0xA8); send_command(0x7F); // Set multiplex ratio 127
-    send_command(0xD3); send_command(0x00); // Display offset
-    send_command(0x40); // Set display start line to 0
-    // Note: Segment remap and COM scan direction will be set by setRotation()
-    send_command(0xDA); send_command(0x12); // COM pins hardware config
-    
-    // Lower initial contrast for power supply stability
-    send_command(0x81); send_command(_config.initial_contrast); // Use configurable contrast
-    
-    send_command(0xA4); // Display RAM on
-    send_command(0xA6); // Normal display
+    const uint8_t setup[] = {
+        0xA8, 0x7F, // Set multiplex ratio 127
+        0xD3, 0x00, // Display offset
+        0x40,       // Set display start line to 0
+        // Note: Segment remap and COM scan direction will be set by setRotation()
+        0xDA, 0x12, // COM pins hardware config
+        // Lower initial contrast for power supply stability
+        0x81, _config.initial_contrast, // Use configurable contrast
+        0xA4,       // Display RAM on
+        0xA6        // Normal display
+    };
+    send_commands(setup, sizeof(setup));
     
     // Additional power supply related settings
     if (_config.low_power_mode) {
-        send_command(0xD5); send_command(0x50); // Even lower clock divide ratio for 3.3V power saving
-        send_command(0xDB); send_command(0x15); // Much lower VCOM deselect level for 3.3V
-        send_command(0xD9); send_command(0x22); // Set pre-charge period (lower power)
+        const uint8_t power[] = {
+            0xD5, 0x50, // Even lower clock divide ratio for 3.3V power saving
+            0xDB, 0x15, // Much lower VCOM deselect level for 3.3V
+            0xD9, 0x22  // Set pre-charge period (lower power)
+        };
+        send_commands(power, sizeof(power));
     } else {
-        send_command(0xD5); send_command(0x80); // Set display clock divide ratio/oscillator frequency
-        send_command(0xDB); send_command(0x35); // Set VCOM deselect level (lower voltage)
+        const uint8_t power[] = {
+            0xD5, 0x80, // Set display clock divide ratio/oscillator frequency
+            0xDB, 0x35  // Set VCOM deselect level (lower voltage)
+        };
+        send_commands(power, sizeof(power));
     }
     
     _initialized = true;
@@ -74,29 +123,74 @@ void HAL::reset() {
     sleep_ms(10);
 }
 
+// The TIMING_STABLE_3V3 delays; TIMING_FAST skips them
+void HAL::pad(uint8_t stable_us) const {
+    if (_config.timing == TIMING_STABLE_3V3) sleep_us(stable_us);
+}
+
 void HAL::send_command(uint8_t cmd) {
+    send_commands(&cmd, 1);
+}
+
+// Multi-byte commands and runs of commands go in one CS frame: the
+// controller takes every byte with DC low as a command byte
+void HAL::send_commands(const uint8_t* cmds, size_t len) {
+    if (_config.bus == BUS_I2C) {
+        // Control byte 0x00 (Co = 0, D/C = 0): the rest are command bytes.
+        // Longer lists go in several transactions; the controller keeps
+        // its place in a multi-byte command between them
+        while (len > 0) {
+            size_t n = (len < I2C_MAX_DATA) ? len : I2C_MAX_DATA;
+            uint16_t* words = _i2c_words[_i2c_next];
+            words[0] = 0x00;
+            for (size_t i = 0; i < n; i++) {
+                words[1 + i] = cmds[i];
+            }
+            words[n] |= I2C_IC_DATA_CMD_STOP_BITS;
+            i2cStart(words, n + 1);
+            cmds += n;
+            len -= n;
+        }
+        return;
+    }
     gpio_put(_config.pin_cs, 0);
-    sleep_us(2); // Longer delay for 3.3V signal stability
+    pad(2); // Longer delay for 3.3V signal stability
     gpio_put(_config.pin_dc, 0); // command
-    spi_tx_blocking(_config.spi_inst, &cmd, 1);
-    sleep_us(2); // Longer delay before CS release
+    spi_tx_blocking(_config.spi_inst, cmds, len);
+    pad(2); // Longer delay before CS release
     gpio_put(_config.pin_cs, 1);
-    sleep_us(5); // Longer inter-command delay for 3.3V power supply stability
+    pad(5); // Longer inter-command delay for 3.3V power supply stability
 }
 
 void HAL::send_data(const uint8_t* data, size_t len) {
+    if (_config.bus == BUS_I2C) {
+        // Control byte 0x40 (Co = 0, D/C = 1): the rest are display data
+        while (len > 0) {
+            size_t n = (len < I2C_MAX_DATA) ? len : I2C_MAX_DATA;
+            uint16_t* words = _i2c_words[_i2c_next];
+            words[0] = 0x40;
+            for (size_t i = 0; i < n; i++) {
+                words[1 + i] = data[i];
+            }
+            words[n] |= I2C_IC_DATA_CMD_STOP_BITS;
+            i2cStart(words, n + 1);
+            data += n;
+            len -= n;
+        }
+        return;
+    }
     gpio_put(_config.pin_cs, 0);
-    sleep_us(2); // Longer delay for 3.3V signal stability
+    pad(2); // Longer delay for 3.3V signal stability
     gpio_put(_config.pin_dc, 1); // data
     spi_tx_blocking(_config.spi_inst, data, len);
-    sleep_us(2); // Longer delay before CS release
+    pad(2); // Longer delay before CS release
     gpio_put(_config.pin_cs, 1);
-    sleep_us(1); // Small delay between data packets
+    pad(1); // Small delay between data packets
 }
 
 void HAL::setContrast(uint8_t v) {
-    send_command(0x81);
-    send_command(v);
+    const uint8_t cmds[] = {0x81, v};
+    send_commands(cmds, sizeof(cmds));
 }
 
 void HAL::setRotation(Rotation r) {
@@ -104,35 +198,134 @@ void HAL::setRotation(Rotation r) {
     
     if (!_initialized) return;
     
-    // SH1107 rotation using segment remap and COM scan direction
+    // SH1107 rotation using segment remap and COM scan direction, sent together
+    uint8_t cmds[2];
     switch (r) {
         case ROTATION_0:
             // Normal orientation
-            send_command(0xA1); // Segment remap (column 127 mapped to SEG0)
-            send_command(0xC8); // COM scan direction (remapped mode, scan from COM[N-1] to COM0)
+            cmds[0] = 0xA1; // Segment remap (column 127 mapped to SEG0)
+            cmds[1] = 0xC8; // COM scan direction (remapped mode, scan from COM[N-1] to COM0)
             break;
         case ROTATION_90:
             // 90 degrees - for OLED this might not be perfectly supported, fallback to 180
-            send_command(0xA0); // Segment remap (column 0 mapped to SEG0)
-            send_command(0xC8); // COM scan direction (remapped mode)
+            cmds[0] = 0xA0; // Segment remap (column 0 mapped to SEG0)
+            cmds[1] = 0xC8; // COM scan direction (remapped mode)
             break;
         case ROTATION_180:
             // 180 degrees rotation
-            send_command(0xA0); // Segment remap (column 0 mapped to SEG0)
-            send_command(0xC0); // COM scan direction (normal mode, scan from COM0 to COM[N-1])
+            cmds[0] = 0xA0; // Segment remap (column 0 mapped to SEG0)
+            cmds[1] = 0xC0; // COM scan direction (normal mode, scan from COM0 to COM[N-1])
             break;
         case ROTATION_270:
             // 270 degrees - for OLED this might not be perfectly supported, fallback to 0
-            send_command(0xA1); // Segment remap (column 127 mapped to SEG0)
-            send_command(0xC0); // COM scan direction (normal mode)
+            cmds[0] = 0xA1; // Segment remap (column 127 mapped to SEG0)
+            cmds[1] = 0xC0; // COM scan direction (normal mode)
             break;
+        default:
+            return;
     }
+    send_commands(cmds, sizeof(cmds));
 }
 
 void HAL::writeCommand(uint8_t cmd) { send_command(cmd); }
+void HAL::writeCommands(const uint8_t* cmds, size_t len) { send_commands(cmds, len); }
 void HAL::writeData(uint8_t data) { send_data(&data, 1); }
 void HAL::writeDataBuffer(const uint8_t* buffer, size_t length) { send_data(buffer, length); }
 
+void HAL::writePage(uint8_t page, uint8_t column, const uint8_t* data, size_t len) {
+    _pages_sent++;
+    if (_config.bus != BUS_I2C) {
+        // Address and data in one CS frame. The SPI write returns once the
+        // last bit is out, so DC can change between them
+        const uint8_t cmds[] = {
+            (uint8_t)(0xB0 | page),
+            (uint8_t)(0x00 | (column & 0x0F)),        // Lower column address
+            (uint8_t)(0x10 | ((column >> 4) & 0x0F))  // Higher column address
+        };
+        gpio_put(_config.pin_cs, 0);
+        pad(2);
+        gpio_put(_config.pin_dc, 0);
+        spi_tx_blocking(_config.spi_inst, cmds, sizeof(cmds));
+        gpio_put(_config.pin_dc, 1);
+        spi_tx_blocking(_config.spi_inst, data, len);
+        pad(2);
+        gpio_put(_config.pin_cs, 1);
+        pad(1);
+        return;
+    }
+
+    // One transaction: each command after a control byte of 0x80 (Co = 1,
+    // D/C = 0), then 0x40 (Co = 0, D/C = 1) and the page data
+    if (len > I2C_MAX_DATA) len = I2C_MAX_DATA;
+    uint16_t* words = _i2c_words[_i2c_next];
+    words[0] = 0x80; words[1] = 0xB0 | page;
+    words[2] = 0x80; words[3] = 0x00 | (column & 0x0F);
+    words[4] = 0x80; words[5] = 0x10 | ((column >> 4) & 0x0F);
+    words[6] = 0x40;
+    for (size_t i = 0; i < len; i++) {
+        words[I2C_PAGE_HEADER + i] = data[i];
+    }
+    words[I2C_PAGE_HEADER + len - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    i2cStart(words, I2C_PAGE_HEADER + len);
+}
+
+// words is the buffer at _i2c_next; the previous transaction, from the
+// other buffer, is waited for first
+void HAL::i2cStart(const uint16_t* words, size_t count) {
+    i2cWait();
+    i2c_hw_t* hw = i2c_get_hw(_config.i2c_inst);
+    (void)hw->clr_stop_det;     // Left over from an aborted transfer
+
+    if (_dma_channel >= 0) {
+        // 16-bit writes keep the STOP bit (bit 9) of each IC_DATA_CMD word
+        dma_channel_config c = dma_channel_get_default_config(_dma_channel);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, i2c_get_dreq(_config.i2c_inst, true));
+        dma_channel_configure(_dma_channel, &c, &hw->data_cmd, words, count, true);
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            while (!i2c_get_write_available(_config.i2c_inst)) {
+                tight_loop_contents();
+            }
+            hw->data_cmd = words[i];
+        }
+    }
+    _i2c_busy = true;
+    _i2c_next ^= 1;
+}
+
+// The DMA is done once the last word is in the FIFO; the transaction is
+// done at its STOP, or when the panel doesn't ACK and the block aborts
+bool HAL::i2cWait() {
+    if (!_i2c_busy) return true;
+    _i2c_busy = false;
+
+    i2c_hw_t* hw = i2c_get_hw(_config.i2c_inst);
+    uint32_t start_us = time_us_32();
+    while (true) {
+        uint32_t stat = hw->raw_intr_stat;
+        if (stat & I2C_IC_RAW_INTR_STAT_STOP_DET_BITS && !(stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)) {
+            (void)hw->clr_stop_det;
+            return true;
+        }
+        if (stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+            uint32_t source = hw->tx_abrt_source;
+            // Stop the DMA before the abort is cleared, or it refills the FIFO
+            if (_dma_channel >= 0) DmaChannels::abort(_dma_channel);
+            (void)hw->clr_tx_abrt;
+            printf("SH1107: I2C transfer aborted (source 0x%08lX)\n", (unsigned long)source);
+            return false;
+        }
+        if (time_us_32() - start_us > I2C_TIMEOUT_US) {
+            if (_dma_channel >= 0) DmaChannels::abort(_dma_channel);
+            printf("SH1107: I2C transfer timed out\n");
+            return false;
+        }
+    }
+}
+
 void HAL::setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
     // SH1107 uses page addressing; we'll set column start and page start
     // Note: driver Graphics implementation converts to page buffers, so nothing needed here for now
@@ -0,0 +1,60 @@
+#include "displays/sh1107/sh1107_pack.hpp"
+
+using namespace sh1107;
+
+// (R + 2G + B) / 4 > 128, with R, G and B scaled to 8 bits
+static inline uint32_t isLit(uint16_t pix) {
+    uint32_t sum = ((pix >> 8) & 0xF8) + ((pix >> 2) & 0x1F8) + ((pix << 3) & 0xF8);
+    return sum > 515;
+}
+
+void sh1107::packRow(const uint16_t* src, int w, uint8_t* bits) {
+    int i = 0;
+    for (; i + 8 <= w; i += 8) {
+        bits[i >> 3] = (uint8_t)(isLit(src[i]) | isLit(src[i + 1]) << 1 | isLit(src[i + 2]) << 2 |
+                                 isLit(src[i + 3]) << 3 | isLit(src[i + 4]) << 4 | isLit(src[i + 5]) << 5 |
+                                 isLit(src[i + 6]) << 6 | isLit(src[i + 7]) << 7);
+    }
+    if (i < w) {
+        uint8_t byte = 0;
+        for (int k = 0; i + k < w; ++k) {
+            byte |= isLit(src[i + k]) << k;
+        }
+        bits[i >> 3] = byte;
+    }
+}
+
+void sh1107::transposePage(const uint8_t* const rows[8], int w, uint8_t* page) {
+    for (int i = 0; i < w; i += 8) {
+        uint64_t block = 0;
+        for (int r = 0; r < 8; ++r) {
+            if (rows[r]) block |= (uint64_t)rows[r][i >> 3] << (8 * r);
+        }
+        block = transpose8x8(block);
+
+        int n = (w - i < 8) ? w - i : 8;
+        for (int c = 0; c < n; ++c) {
+            page[i + c] = (uint8_t)(block >> (8 * c));
+        }
+    }
+}
+
+void sh1107::buildPage(const displays::ImageRegion& region, int page, int draw_x, int w, uint8_t* out) {
+    uint8_t bits[8][MAX_PAGE_WIDTH / 8];
+    const uint8_t* rows[8];
+    const int src_x = draw_x - region.x;
+    if (w > MAX_PAGE_WIDTH) w = MAX_PAGE_WIDTH;
+
+    // Each screen row is in one page only, so every source row is
+    // thresholded once per draw
+    for (int r = 0; r < 8; ++r) {
+        int src_y = page * 8 + r - region.y;
+        if (src_y < 0 || src_y >= region.h) {
+            rows[r] = nullptr;
+            continue;
+        }
+        packRow(region.pixels + src_y * region.stride + src_x, w, bits[r]);
+        rows[r] = bits[r];
+    }
+    transposePage(rows, w, out);
+}
@@ -65,23 +65,37 @@ void fast_bayer_dither(uint16_t* buf, int w, int h, const uint16_t palette[4], u
 }
 
 void floyd_steinberg_dither(uint16_t* buf, int w, int h, const uint16_t palette[4], uint16_t bw_white, uint16_t bw_black) {
-    // Create a working buffer with error accumulation (use int32 to handle error propagation)
-    static int32_t error_buf[128 * 128]; // Assuming max size, adjust if needed
+    if (w > DITHER_MAX_WIDTH) {
+        fast_bayer_dither(buf, w, h, palette, bw_white, bw_black);
+        return;
+    }
+
+    // Error only spreads to the next row, so two rows of luminance plus
+    // accumulated error are enough (int32 to handle error propagation)
+    static int32_t error_rows[2][DITHER_MAX_WIDTH];
     
     // Calculate target luminance values
     int target_white = rgb565_to_luma_accurate(bw_white);
     int target_black = rgb565_to_luma_accurate(bw_black);
     int mid_luma = (target_white + target_black) / 2;
     
-    // Initialize error buffer with input luminance values
-    for (int i = 0; i < w * h; i++) {
-        error_buf[i] = rgb565_to_luma_accurate(buf[i]);
+    // Initialize the first row with input luminance values
+    for (int x = 0; x < w; x++) {
+        error_rows[0][x] = rgb565_to_luma_accurate(buf[x]);
     }
     
     for (int y = 0; y < h; y++) {
+        int32_t* cur = error_rows[y & 1];
+        int32_t* next = error_rows[(y + 1) & 1];
+        if (y + 1 < h) {
+            for (int x = 0; x < w; x++) {
+                next[x] = rgb565_to_luma_accurate(buf[(y + 1) * w + x]);
+            }
+        }
+
         for (int x = 0; x < w; x++) {
             int idx = y * w + x;
-            int old_pixel = error_buf[idx];
+            int old_pixel = cur[x];
             
             // Determine new pixel value
             uint16_t new_pixel = (old_pixel >= mid_luma) ? bw_white : bw_black;
@@ -97,15 +111,15 @@ void floyd_steinberg_dither(uint16_t* buf, int w, int h, const uint16_t palette[
             //     X 7
             //   3 5 1
             if (x + 1 < w) {
-                error_buf[idx + 1] += (error * 7) / 16;
+                cur[x + 1] += (error * 7) / 16;
             }
             if (y + 1 < h) {
                 if (x > 0) {
-                    error_buf[idx + w - 1] += (error * 3) / 16;
+                    next[x - 1] += (error * 3) / 16;
                 }
-                error_buf[idx + w] += (error * 5) / 16;
+                next[x] += (error * 5) / 16;
                 if (x + 1 < w) {
-                    error_buf[idx + w + 1] += (error * 1) / 16;
+                    next[x + 1] += (error * 1) / 16;
                 }
             }
         }
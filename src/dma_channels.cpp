@@ -0,0 +1,96 @@
+#include "dma_channels.hpp"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+DmaChannels::Slot DmaChannels::_slots[NUM_DMA_CHANNELS];
+uint32_t DmaChannels::_claimed = 0;
+uint32_t DmaChannels::_routed[2] = {0, 0};
+bool DmaChannels::_installed[2] = {false, false};
+
+int DmaChannels::claim(Handler handler, void* context, uint irq_index) {
+    if (irq_index > 1) {
+        return -1;
+    }
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0) {
+        return -1;
+    }
+    _claimed |= 1u << channel;
+
+    if (handler) {
+        uint32_t irq_state = save_and_disable_interrupts();
+        _slots[channel] = {handler, context};
+        _routed[irq_index] |= 1u << channel;
+        restore_interrupts(irq_state);
+
+        if (!_installed[irq_index]) {
+            // Shared, so SDK code that also uses the line keeps working
+            uint irq = irq_index ? DMA_IRQ_1 : DMA_IRQ_0;
+            irq_add_shared_handler(irq, irq_index ? irq1 : irq0,
+                                   PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+            irq_set_enabled(irq, true);
+            _installed[irq_index] = true;
+        }
+        dma_irqn_set_channel_enabled(irq_index, channel, true);
+    }
+    return channel;
+}
+
+void DmaChannels::unclaim(int channel) {
+    if (channel < 0 || !isClaimed(channel)) {
+        return;
+    }
+    uint32_t bit = 1u << channel;
+    for (uint irq_index = 0; irq_index < 2; irq_index++) {
+        if (_routed[irq_index] & bit) {
+            dma_irqn_set_channel_enabled(irq_index, channel, false);
+            dma_irqn_acknowledge_channel(irq_index, channel);
+        }
+    }
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    _routed[0] &= ~bit;
+    _routed[1] &= ~bit;
+    _slots[channel] = {nullptr, nullptr};
+    restore_interrupts(irq_state);
+
+    _claimed &= ~bit;
+    dma_channel_unclaim(channel);
+}
+
+void DmaChannels::abort(uint channel) {
+    uint32_t bit = 1u << channel;
+    for (uint irq_index = 0; irq_index < 2; irq_index++) {
+        if (_routed[irq_index] & bit) {
+            dma_irqn_set_channel_enabled(irq_index, channel, false);
+        }
+    }
+    dma_channel_abort(channel);
+    for (uint irq_index = 0; irq_index < 2; irq_index++) {
+        if (_routed[irq_index] & bit) {
+            dma_irqn_acknowledge_channel(irq_index, channel);
+            dma_irqn_set_channel_enabled(irq_index, channel, true);
+        }
+    }
+}
+
+// Only the channels routed to this line: anything else flagged on it
+// belongs to another shared handler
+void DmaChannels::dispatch(uint irq_index) {
+    io_rw_32* ints = irq_index ? &dma_hw->ints1 : &dma_hw->ints0;
+    uint32_t pending = *ints & _routed[irq_index];
+    while (pending) {
+        uint channel = __builtin_ctz(pending);
+        pending &= pending - 1;
+        *ints = 1u << channel;
+        _slots[channel].handler(_slots[channel].context);
+    }
+}
+
+void DmaChannels::irq0() {
+    dispatch(0);
+}
+
+void DmaChannels::irq1() {
+    dispatch(1);
+}
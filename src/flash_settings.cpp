@@ -0,0 +1,65 @@
+#include "flash_settings.hpp"
+#include <cstring>
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+// Last sector, clear of the program image
+static const uint32_t SETTINGS_OFFSET = PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE;
+static const uint32_t SETTINGS_MAGIC = 0x53474D44;  // "DMGS"
+
+struct Record {
+    uint32_t magic;
+    uint32_t key;
+    uint32_t len;
+    uint32_t check;
+    uint8_t data[FlashSettings::MAX_DATA];
+};
+static_assert(sizeof(Record) <= FLASH_PAGE_SIZE, "A record is programmed as one page");
+
+static uint32_t recordCheck(uint32_t key, const void* data, size_t len) {
+    return FlashSettings::hash(data, len, FlashSettings::hash(&key, sizeof(key)));
+}
+
+uint32_t FlashSettings::hash(const void* data, size_t len, uint32_t seed) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t h = seed;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ bytes[i]) * 16777619u;
+    }
+    return h;
+}
+
+bool FlashSettings::load(uint32_t key, void* data, size_t len) {
+    const Record* record = (const Record*)(XIP_BASE + SETTINGS_OFFSET);
+    if (len > MAX_DATA || record->magic != SETTINGS_MAGIC || record->key != key || record->len != len ||
+        record->check != recordCheck(key, record->data, len)) {
+        return false;
+    }
+    memcpy(data, record->data, len);
+    return true;
+}
+
+bool FlashSettings::save(uint32_t key, const void* data, size_t len) {
+    if (len > MAX_DATA) {
+        return false;
+    }
+    uint8_t current[MAX_DATA];
+    if (load(key, current, len) && memcmp(current, data, len) == 0) {
+        return true;  // Spare the erase cycle
+    }
+
+    alignas(4) uint8_t page[FLASH_PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    Record* record = (Record*)page;
+    record->magic = SETTINGS_MAGIC;
+    record->key = key;
+    record->len = len;
+    memcpy(record->data, data, len);
+    record->check = recordCheck(key, record->data, len);
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    flash_range_erase(SETTINGS_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(SETTINGS_OFFSET, page, FLASH_PAGE_SIZE);
+    restore_interrupts(irq_state);
+    return true;
+}
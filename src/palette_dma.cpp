@@ -0,0 +1,187 @@
+#include "palette_dma.hpp"
+#include "hardware/dma.h"
+#include "dma_channels.hpp"
+#include "hardware/gpio.h"
+#include "palette_lookup.pio.h"
+#include <cstdio>
+
+PaletteDma::PaletteDma() :
+    _spi(nullptr), _pin_cs(0), _pin_dc(0), _pio(nullptr), _sm(-1), _offset(0),
+    _ch_feed(-1), _ch_addr(-1), _ch_data(-1), _dma_enabled(false), _busy(false) {
+    for (int i = 0; i < 4; i++) {
+        _table[i] = 0;
+    }
+}
+
+PaletteDma::~PaletteDma() {
+    wait();
+    release();
+}
+
+void PaletteDma::setPalette(const uint16_t palette[4]) {
+    // Store byte-swapped so the data channel can send entries byte by byte
+    for (int i = 0; i < 4; i++) {
+        _table[i] = (uint16_t)((palette[i] >> 8) | (palette[i] << 8));
+    }
+}
+
+bool PaletteDma::init(spi_inst_t* spi, uint8_t pin_cs, uint8_t pin_dc, PIO pio, const uint16_t palette[4]) {
+    _spi = spi;
+    _pin_cs = pin_cs;
+    _pin_dc = pin_dc;
+    _pio = pio;
+    setPalette(palette);
+
+    if (!pio_can_add_program(pio, &palette_lookup_program)) {
+        printf("PaletteDma: no PIO program space, using CPU expansion\n");
+        return false;
+    }
+    _sm = pio_claim_unused_sm(pio, false);
+    _ch_feed = DmaChannels::claim();
+    _ch_addr = DmaChannels::claim();
+    _ch_data = DmaChannels::claim();
+    if (_sm < 0 || _ch_feed < 0 || _ch_addr < 0 || _ch_data < 0) {
+        printf("PaletteDma: no free state machine or DMA channels, using CPU expansion\n");
+        release();
+        return false;
+    }
+
+    _offset = pio_add_program(pio, &palette_lookup_program);
+    palette_lookup_program_init(pio, _sm, _offset, (uint32_t)(uintptr_t)_table);
+
+    // data: one palette entry (2 bytes) to SPI, then hand back to addr.
+    // IRQ_QUIET keeps normal completions silent, so the only interrupt
+    // flag raised is the one from the end-of-frame null trigger.
+    dma_channel_config c = dma_channel_get_default_config(_ch_data);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, spi_get_dreq(spi, true));
+    channel_config_set_chain_to(&c, _ch_addr);
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(_ch_data, &c, &spi_get_hw(spi)->dr, _table, 2, false);
+
+    // addr: one entry address from the PIO into data's read address trigger
+    c = dma_channel_get_default_config(_ch_addr);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, _sm, false));
+    dma_channel_configure(_ch_addr, &c, &dma_hw->ch[_ch_data].al3_read_addr_trig,
+                          &pio->rxf[_sm], 1, false);
+
+    // feed: index words into the PIO
+    c = dma_channel_get_default_config(_ch_feed);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, _sm, true));
+    dma_channel_configure(_ch_feed, &c, &pio->txf[_sm], nullptr, 0, false);
+
+    _dma_enabled = true;
+    printf("PaletteDma: DMA lookup on PIO%d SM%d, channels %d/%d/%d\n",
+           pio_get_index(pio), _sm, _ch_feed, _ch_addr, _ch_data);
+    return true;
+}
+
+void PaletteDma::release() {
+    DmaChannels::unclaim(_ch_feed);
+    DmaChannels::unclaim(_ch_addr);
+    DmaChannels::unclaim(_ch_data);
+    _ch_feed = _ch_addr = _ch_data = -1;
+
+    if (_sm >= 0) {
+        pio_sm_set_enabled(_pio, _sm, false);
+        if (_dma_enabled) {
+            pio_remove_program(_pio, &palette_lookup_program, _offset);
+        }
+        pio_sm_unclaim(_pio, _sm);
+        _sm = -1;
+    }
+    _dma_enabled = false;
+}
+
+void PaletteDma::start(uint8_t* indices, size_t count) {
+    wait();
+
+    // End-of-frame marker, padded to a whole word
+    for (size_t i = 0; i < PADDING; i++) {
+        indices[count + i] = 0;
+    }
+
+    gpio_put(_pin_dc, 1);  // Data mode
+    gpio_put(_pin_cs, 0);  // Select
+
+    if (!_dma_enabled) {
+        writeSoftware(indices, count);
+        gpio_put(_pin_cs, 1);
+        return;
+    }
+
+    // Drop anything left over from the last frame's padding. The restart
+    // marks the OSR full (of zeros, which would read as the end marker),
+    // so shift it out: the first out then autopulls the first index word
+    pio_sm_set_enabled(_pio, _sm, false);
+    pio_sm_clear_fifos(_pio, _sm);
+    pio_sm_restart(_pio, _sm);
+    pio_sm_exec(_pio, _sm, pio_encode_out(pio_null, 32));
+    pio_sm_exec(_pio, _sm, pio_encode_jmp(_offset + palette_lookup_offset_top));
+    pio_sm_set_enabled(_pio, _sm, true);
+
+    dma_hw->intr = 1u << _ch_data;
+    _busy = true;
+
+    dma_channel_start(_ch_addr);
+    dma_channel_set_trans_count(_ch_feed, (count + PADDING) / 4, false);
+    dma_channel_set_read_addr(_ch_feed, indices, true);
+}
+
+bool PaletteDma::isBusy() const {
+    return _busy && !(dma_hw->intr & (1u << _ch_data));
+}
+
+void PaletteDma::wait() {
+    if (!_busy) {
+        return;
+    }
+    while (isBusy()) {
+        tight_loop_contents();
+    }
+    finish();
+}
+
+void PaletteDma::finish() {
+    dma_channel_abort(_ch_feed);
+    dma_hw->intr = 1u << _ch_data;
+
+    // Let the last pixel shift out, then discard what the SPI clocked in
+    while (spi_is_busy(_spi)) {
+        tight_loop_contents();
+    }
+    while (spi_is_readable(_spi)) {
+        (void)spi_get_hw(_spi)->dr;
+    }
+    spi_get_hw(_spi)->icr = SPI_SSPICR_RORIC_BITS;
+
+    gpio_put(_pin_cs, 1);  // Deselect
+    _busy = false;
+}
+
+void PaletteDma::writeSoftware(const uint8_t* indices, size_t count) {
+    // _table is already in wire order
+    const uint8_t* table = (const uint8_t*)_table;
+    uint8_t chunk[256];
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* entry = &table[(indices[i] & 3) << 1];
+        chunk[n++] = entry[0];
+        chunk[n++] = entry[1];
+        if (n == sizeof(chunk)) {
+            spi_write_blocking(_spi, chunk, n);
+            n = 0;
+        }
+    }
+    if (n > 0) {
+        spi_write_blocking(_spi, chunk, n);
+    }
+}
@@ -0,0 +1,38 @@
+#include "pixel_pack.hpp"
+
+void buildRgb444PairLut(const uint16_t rgb444[4], uint8_t lut[16][3]) {
+    for (int a = 0; a < 4; a++) {
+        for (int b = 0; b < 4; b++) {
+            uint16_t p0 = rgb444[a];
+            uint16_t p1 = rgb444[b];
+            uint8_t* out = lut[(a << 2) | b];
+            out[0] = (uint8_t)(p0 >> 4);                       // R1 G1
+            out[1] = (uint8_t)(((p0 & 0x0F) << 4) | (p1 >> 8)); // B1 R2
+            out[2] = (uint8_t)(p1 & 0xFF);                     // G2 B2
+        }
+    }
+}
+
+void packRowRgb444(const uint8_t* src, const int* xmap, int width,
+                   const uint8_t lut[16][3], uint8_t* dst) {
+    int dx = 0;
+    // Two pairs (four pixels, six bytes) per iteration
+    for (; dx <= width - 4; dx += 4) {
+        const uint8_t* p0 = lut[(src[xmap[dx]] << 2) | src[xmap[dx + 1]]];
+        const uint8_t* p1 = lut[(src[xmap[dx + 2]] << 2) | src[xmap[dx + 3]]];
+        dst[0] = p0[0];
+        dst[1] = p0[1];
+        dst[2] = p0[2];
+        dst[3] = p1[0];
+        dst[4] = p1[1];
+        dst[5] = p1[2];
+        dst += 6;
+    }
+    for (; dx < width; dx += 2) {
+        const uint8_t* p = lut[(src[xmap[dx]] << 2) | src[xmap[dx + 1]]];
+        dst[0] = p[0];
+        dst[1] = p[1];
+        dst[2] = p[2];
+        dst += 3;
+    }
+}
@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""Compile include/palettes.txt into constexpr palette tables.
+
+Usage: gen_palettes.py <palettes.txt> <output.hpp> [panels.txt]
+
+Every palette is emitted as a PaletteTables struct holding each form the
+capture and display pipeline needs (RGB565, SPI wire order, RGB444, luma),
+so nothing has to be converted by hand or at runtime.
+
+When a panel profile file is given, every palette is also emitted once per
+panel under palettes::<panel>, with that panel's gamma, white point and
+inversion correction already applied.
+"""
+
+import re
+import sys
+
+# Shade shown for each Game Boy capture value ((LD1 << 1) | LD0), where
+# shade 0 is the lightest and 3 the darkest.
+CAPTURE_ORDER = (0, 2, 1, 3)
+
+NAME_RE = re.compile(r"^[A-Z][A-Z0-9_]*$")
+
+# Gamma the palettes are authored for (sRGB-like display)
+SOURCE_GAMMA = 2.2
+
+
+def strip_comment(raw):
+    # '#' starts a comment unless it is a #RRGGBB colour
+    return re.sub(r"(^|\s)#(?![0-9A-Fa-f]{6}\b).*$", "", raw).strip()
+
+
+def parse_color(token, where):
+    if token.startswith("#") and len(token) == 7:
+        rgb = int(token[1:], 16)
+        r, g, b = (rgb >> 16) & 0xFF, (rgb >> 8) & 0xFF, rgb & 0xFF
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+    if token.lower().startswith("0x"):
+        value = int(token, 16)
+        if value <= 0xFFFF:
+            return value
+    raise ValueError(f"{where}: bad colour '{token}'")
+
+
+def parse_palettes(path):
+    palettes = []
+    seen = set()
+    with open(path, encoding="utf-8") as f:
+        for lineno, raw in enumerate(f, 1):
+            line = strip_comment(raw)
+            if not line:
+                continue
+            where = f"{path}:{lineno}"
+            tokens = line.replace(",", " ").split()
+            name = tokens[0]
+            if not NAME_RE.match(name):
+                raise ValueError(f"{where}: bad palette name '{name}'")
+            if name in seen:
+                raise ValueError(f"{where}: duplicate palette '{name}'")
+            if len(tokens) != 5:
+                raise ValueError(f"{where}: expected 4 colours, got {len(tokens) - 1}")
+            shades = [parse_color(t, where) for t in tokens[1:]]
+            seen.add(name)
+            palettes.append((name, shades))
+    if not palettes:
+        raise ValueError(f"{path}: no palettes defined")
+    return palettes
+
+
+def parse_panels(path):
+    panels = []
+    seen = set()
+    with open(path, encoding="utf-8") as f:
+        for lineno, raw in enumerate(f, 1):
+            line = strip_comment(raw)
+            if not line:
+                continue
+            where = f"{path}:{lineno}"
+            tokens = line.split()
+            name = tokens[0].lower()
+            if not re.match(r"^[a-z][a-z0-9_]*$", name) or name in seen:
+                raise ValueError(f"{where}: bad or duplicate panel name '{tokens[0]}'")
+            profile = {"gamma": SOURCE_GAMMA, "white": (255, 255, 255), "invert": False}
+            for opt in tokens[1:]:
+                key, _, value = opt.partition("=")
+                try:
+                    if key == "gamma":
+                        profile["gamma"] = float(value)
+                        if not 1.0 <= profile["gamma"] <= 3.5:
+                            raise ValueError
+                    elif key == "white":
+                        white = tuple(int(v) for v in value.split(","))
+                        if len(white) != 3 or not all(0 <= v <= 255 for v in white):
+                            raise ValueError
+                        profile["white"] = white
+                    elif key == "invert":
+                        profile["invert"] = {"0": False, "1": True}[value]
+                    else:
+                        raise ValueError
+                except (ValueError, KeyError):
+                    raise ValueError(f"{where}: bad option '{opt}'")
+            seen.add(name)
+            panels.append((name, profile))
+    return panels
+
+
+def correct(c, profile):
+    """Apply a panel profile to an RGB565 colour, returning RGB565.
+
+    The intended light output is computed with the source gamma and the
+    white point gains, then encoded with the panel's own gamma.
+    """
+    out = []
+    for v8, gain, bits in zip(expand565(c), profile["white"], (5, 6, 5)):
+        light = (v8 / 255.0) ** SOURCE_GAMMA * (gain / 255.0)
+        v = light ** (1.0 / profile["gamma"])
+        out.append(min((1 << bits) - 1, int(v * ((1 << bits) - 1) + 0.5)))
+    c = (out[0] << 11) | (out[1] << 5) | out[2]
+    return c ^ 0xFFFF if profile["invert"] else c
+
+
+def expand565(c):
+    r, g, b = (c >> 11) & 0x1F, (c >> 5) & 0x3F, c & 0x1F
+    return (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)
+
+
+def to_wire(c):
+    return ((c & 0xFF) << 8) | (c >> 8)
+
+
+def to_rgb444(c):
+    r8, g8, b8 = expand565(c)
+    q = lambda v: (v * 15 + 127) // 255
+    return (q(r8) << 8) | (q(g8) << 4) | q(b8)
+
+
+def to_luma(c):
+    r8, g8, b8 = expand565(c)
+    return (299 * r8 + 587 * g8 + 114 * b8) // 1000
+
+
+def hex_list(values, digits):
+    return ", ".join(f"0x{v:0{digits}X}" for v in values)
+
+
+def render_palette(name, colors, indent=""):
+    return [
+        f"{indent}constexpr PaletteTables PALETTE_{name} = {{",
+        f"{indent}    {{ {hex_list(colors, 4)} }},",
+        f"{indent}    {{ {hex_list([to_wire(c) for c in colors], 4)} }},",
+        f"{indent}    {{ {hex_list([to_rgb444(c) for c in colors], 3)} }},",
+        f"{indent}    {{ {', '.join(str(to_luma(c)) for c in colors)} }},",
+        f"{indent}}};",
+        "",
+    ]
+
+
+def render(palettes, panels, sources):
+    out = [
+        f"// Generated by tools/gen_palettes.py from {' and '.join(sources)} - do not edit.",
+        "#pragma once",
+        "#include <cstdint>",
+        "",
+        "// Entries are in Game Boy capture order, indexed by (LD1 << 1) | LD0:",
+        "// 0: lightest, 1: dark, 2: light, 3: darkest",
+        "struct PaletteTables {",
+        "    uint16_t rgb565[4];   // RGB565",
+        "    uint16_t wire[4];     // RGB565 byte-swapped, high byte first in memory",
+        "    uint16_t rgb444[4];   // RGB444 as 0x0RGB",
+        "    uint8_t luma[4];      // BT.601 luma (0-255)",
+        "};",
+        "",
+    ]
+    for name, shades in palettes:
+        out += render_palette(name, [shades[s] for s in CAPTURE_ORDER])
+    for panel, profile in panels:
+        white = ",".join(str(v) for v in profile["white"])
+        out += [
+            f"// {panel}: gamma {profile['gamma']:g}, white {white}, invert {int(profile['invert'])}",
+            f"namespace palettes::{panel} {{",
+            "",
+        ]
+        for name, shades in palettes:
+            colors = [correct(shades[s], profile) for s in CAPTURE_ORDER]
+            out += render_palette(name, colors, "    ")
+        out += [f"}} // namespace palettes::{panel}", ""]
+    return "\n".join(out)
+
+
+def main(argv):
+    if len(argv) not in (3, 4):
+        sys.stderr.write(__doc__)
+        return 2
+    src, dst = argv[1], argv[2]
+    sources = [src]
+    try:
+        palettes = parse_palettes(src)
+        panels = []
+        if len(argv) == 4:
+            panels = parse_panels(argv[3])
+            sources.append(argv[3])
+    except ValueError as e:
+        sys.stderr.write(f"gen_palettes: {e}\n")
+        return 1
+    text = render(palettes, panels, [p.replace("\\", "/").split("/")[-1] for p in sources])
+    with open(dst, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,221 @@
+// Host model of the 8080 parallel bus (pio/lcd_8080). Runs the assembled
+// lcd_8080_8 and lcd_8080_16 programs on the PIO interpreter in
+// pio_model.hpp, fed with the FIFO words the transfer queue writes (CPU
+// bytes and pixels, 8- and 16-bit DMA writes, which the bus fabric repeats
+// across the word), and decodes the pin stream back into commands,
+// parameters and pixels the way a panel latches them on each WR rising
+// edge. Fails if the decoded stream
+// differs from what was sent, or if a strobe breaks the bus rules (write
+// cycle under two state machine clocks, data or DC changing under WR or CS).
+//
+//   pioasm pio/lcd_8080/lcd_8080.pio lcd_8080.pio.h
+//   g++ -std=c++17 -DPICO_NO_HARDWARE=1 -I. tools/lcd_8080_model.cpp -o lcd_8080_model
+//   ./lcd_8080_model
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "lcd_8080.pio.h"
+#include "pio_model.hpp"
+
+// Pin levels after one state machine clock
+struct Pins {
+    bool cs;
+    bool wr;
+    bool dc;
+    uint32_t data;
+};
+
+// OSR shifting left without autopull, side-set of two pins (CS, WR), one
+// set pin (DC), as lcd_8080_program_init configures it
+static PioConfig config(uint8_t width) {
+    PioConfig c;
+    c.sideset_bits = 2;
+    c.out_count = width;
+    c.set_count = 1;
+    return c;
+}
+
+static Pins pins(const PioStateMachine& sm) {
+    return {(sm.sidesetPins() & 1) != 0, (sm.sidesetPins() & 2) != 0, sm.setPins() != 0, sm.outPins()};
+}
+
+// One command with the parameters or pixels that followed it
+struct Transaction {
+    uint8_t cmd;
+    std::vector<uint16_t> data;
+    bool operator==(const Transaction& other) const { return cmd == other.cmd && data == other.data; }
+};
+
+static const uint8_t RAMWR = 0x2C;
+
+// FIFO words as TransferQueue writes them (see lcd_spi_header and byteWord)
+struct Stream {
+    std::vector<uint32_t> words;
+    std::vector<Transaction> expected;
+
+    static uint32_t header(bool dc, uint32_t bits, uint32_t count) {
+        return ((uint32_t)dc << 31) | ((bits - 1) << 26) | ((count - 1) & 0x3FFFFFF);
+    }
+    void command(uint8_t cmd, std::vector<uint8_t> params) {
+        words.push_back(header(false, 8, 1));
+        words.push_back(cmd * 0x01010101u);
+        expected.push_back({cmd, {}});
+        if (!params.empty()) {
+            data(params);
+        }
+    }
+    void data(const std::vector<uint8_t>& bytes) {  // CPU or 8-bit DMA, same word
+        words.push_back(header(true, 8, bytes.size()));
+        for (uint8_t b : bytes) {
+            words.push_back(b * 0x01010101u);
+            expected.back().data.push_back(b);
+        }
+    }
+    void pixels(const std::vector<uint16_t>& px, bool dma) {
+        words.push_back(header(true, 16, px.size()));
+        for (uint16_t p : px) {
+            words.push_back(dma ? p * 0x00010001u : (uint32_t)p << 16);
+            expected.back().data.push_back(p);
+        }
+    }
+};
+
+// Panel side: latch D and DC on every WR rising edge
+static bool decode(const std::vector<Pins>& trace, uint8_t width, std::vector<Transaction>& out,
+                   std::vector<size_t>& pixel_clocks) {
+    int byte_hi = -1;
+    size_t low_start = 0;
+    size_t last_rise = 0;
+    bool have_rise = false;
+    for (size_t i = 1; i < trace.size(); i++) {
+        const Pins& prev = trace[i - 1];
+        const Pins& cur = trace[i];
+        if (!prev.cs && !cur.cs && prev.dc != cur.dc) {
+            printf("DC changed with CS low at clock %zu\n", i);
+            return false;
+        }
+        if (prev.wr && !cur.wr) {
+            low_start = i;
+        }
+        if (!cur.wr && cur.data != trace[low_start].data) {
+            printf("data changed with WR low at clock %zu\n", i);
+            return false;
+        }
+        if (prev.wr || !cur.wr) {
+            continue;
+        }
+
+        // Rising edge: the panel takes what was on the bus
+        if (prev.cs || cur.cs) {
+            printf("WR strobe with CS high at clock %zu\n", i);
+            return false;
+        }
+        if (cur.data != prev.data) {
+            printf("no data hold after WR at clock %zu\n", i);
+            return false;
+        }
+        if (have_rise && i - last_rise < 2) {
+            printf("write cycle under two clocks at clock %zu\n", i);
+            return false;
+        }
+        have_rise = true;
+        last_rise = i;
+
+        if (!prev.dc) {
+            out.push_back({(uint8_t)prev.data, {}});
+            byte_hi = -1;
+            continue;
+        }
+        if (out.empty()) {
+            printf("data before any command\n");
+            return false;
+        }
+        Transaction& t = out.back();
+        if (t.cmd != RAMWR) {
+            t.data.push_back(prev.data & 0xFF);     // Parameters on D0-D7
+            continue;
+        }
+        if (width == 16) {
+            t.data.push_back((uint16_t)prev.data);
+            pixel_clocks.push_back(i);
+        } else if (byte_hi < 0) {
+            byte_hi = prev.data;
+        } else {
+            t.data.push_back((uint16_t)(byte_hi << 8 | prev.data));
+            pixel_clocks.push_back(i);
+            byte_hi = -1;
+        }
+    }
+    return true;
+}
+
+static bool run(const char* name, const uint16_t* program, uint8_t wrap_target, uint8_t wrap, uint8_t width) {
+    Stream stream;
+    stream.command(0x2A, {0x00, 0x20, 0x01, 0x5F});
+    stream.command(0x2B, {0x00, 0x10, 0x01, 0x2F});
+    stream.command(RAMWR, {});
+    std::vector<uint16_t> frame(320 * 4);
+    for (size_t i = 0; i < frame.size(); i++) frame[i] = (uint16_t)(i * 0x9E37 + 0x1234);
+    stream.pixels(frame, true);             // DMA from a frame buffer
+    stream.command(0x36, {});
+    stream.data({0x48});                    // DMA bytes
+    stream.command(RAMWR, {});
+    stream.pixels({0xF800, 0x07E0, 0x001F, 0xFFFF, 0x0000, 0xA5C3}, false);  // CPU writes
+    stream.command(RAMWR, {});
+    stream.pixels(std::vector<uint16_t>(100, 0x8410), true);                  // Fill
+
+    PioStateMachine sm(program, wrap_target, wrap, config(width));
+    sm.setPins(0b11, 1, 0);                 // CS, WR and DC high, data low
+    sm.txf.assign(stream.words.begin(), stream.words.end());
+    std::vector<Pins> trace;
+    trace.push_back(pins(sm));
+    int idle = 0;
+    while (idle < 4) {
+        bool ran = sm.clock();
+        trace.push_back(pins(sm));
+        idle = (!ran && sm.txf.empty()) ? idle + 1 : 0;
+        if (trace.size() > 1000000) {
+            printf("%s: program never went idle\n", name);
+            return false;
+        }
+    }
+    if (!trace.back().cs) {
+        printf("%s: CS still low when idle\n", name);
+        return false;
+    }
+
+    std::vector<Transaction> got;
+    std::vector<size_t> pixel_clocks;
+    if (!decode(trace, width, got, pixel_clocks)) {
+        printf("%s: bus rules broken\n", name);
+        return false;
+    }
+    if (got != stream.expected) {
+        printf("%s: decoded %zu transactions, expected %zu\n", name, got.size(), stream.expected.size());
+        for (size_t i = 0; i < got.size() && i < stream.expected.size(); i++) {
+            if (!(got[i] == stream.expected[i])) {
+                printf("  first difference: command %02X, %zu vs %zu values\n", got[i].cmd,
+                       got[i].data.size(), stream.expected[i].data.size());
+                break;
+            }
+        }
+        return false;
+    }
+
+    // Streaming rate over the frame buffer burst; the state machine runs
+    // at twice the WR rate
+    double clocks = (double)(pixel_clocks[frame.size() - 1] - pixel_clocks[0]) / (frame.size() - 1);
+    const double write_hz = 15e6;
+    double frame_ms = clocks * 320 * 288 / (2 * write_hz) * 1000;
+    printf("%s: %zu transactions decoded, %.1f clocks per pixel, 320x288 in %.1f ms at %.0f MHz WR\n",
+           name, got.size(), clocks, frame_ms, write_hz / 1e6);
+    return true;
+}
+
+int main() {
+    bool ok = true;
+    ok &= run("8-bit bus", lcd_8080_8_program_instructions, lcd_8080_8_wrap_target, lcd_8080_8_wrap, 8);
+    ok &= run("16-bit bus", lcd_8080_16_program_instructions, lcd_8080_16_wrap_target, lcd_8080_16_wrap, 16);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+// Host model of the DMA palette lookup (src/palette_dma.cpp). Runs the
+// assembled palette_lookup program on the PIO interpreter in pio_model.hpp,
+// with the three DMA channels around it: feed (index words to the TX FIFO),
+// addr (RX FIFO to the data channel's read address trigger) and data (two
+// palette bytes to the SPI, then chain back to addr). Each frame is set
+// up the way PaletteDma::init() and start() do it, restart included, and
+// several frames go through the same state machine. Fails if the SPI
+// bytes of a frame differ from the palette expansion of its indices, or
+// if the chain doesn't stop on the null trigger after the last pixel. A
+// start without emptying the OSR after the restart must fail too.
+//
+//   pioasm pio/palette_lookup/palette_lookup.pio palette_lookup.pio.h
+//   g++ -std=c++17 -DPICO_NO_HARDWARE=1 -I. tools/palette_dma_model.cpp -o palette_dma_model
+//   ./palette_dma_model
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "palette_lookup.pio.h"
+#include "pio_model.hpp"
+
+static const uint8_t INDEX_MARK = 0x04;     // As in PaletteDma
+static const size_t PADDING = 4;
+static const uint32_t TABLE_ADDR = 0x20001238;  // 8-byte aligned, as alignas(8) _table
+static const size_t FIFO_DEPTH = 4;
+
+// Instructions PaletteDma executes on the state machine
+static const uint16_t PULL_BLOCK = 0x80A0;
+static const uint16_t OUT_Y_32 = 0x6040;
+static const uint16_t OUT_NULL_32 = 0x6060;
+
+// The chain around the state machine, set up as PaletteDma does it
+class Chain {
+public:
+    Chain() : _sm(palette_lookup_program_instructions, palette_lookup_wrap_target, palette_lookup_wrap, config()) {
+        _sm.enabled = false;
+    }
+
+    // PaletteDma::init(): palette_lookup_program_init loads the table base into Y
+    void init() {
+        _sm.clearFifos();
+        _sm.restart();
+        _sm.txf.push_back(TABLE_ADDR >> 3);
+        _sm.exec(PULL_BLOCK);
+        _sm.exec(OUT_Y_32);
+        _sm.enabled = true;
+    }
+
+    void setPalette(const uint16_t palette[4]) {
+        for (int i = 0; i < 4; i++) {
+            // Byte-swapped, so byte order in memory is wire order
+            _table[2 * i] = palette[i] >> 8;
+            _table[2 * i + 1] = palette[i] & 0xFF;
+        }
+    }
+
+    // PaletteDma::start(), with or without emptying the OSR after the restart
+    void start(const std::vector<uint32_t>& words, size_t count, bool empty_osr) {
+        _sm.enabled = false;
+        _sm.clearFifos();
+        _sm.restart();
+        if (empty_osr) _sm.exec(OUT_NULL_32);
+        _sm.exec(0x0000 | palette_lookup_offset_top);    // jmp top
+        _sm.enabled = true;
+
+        _irq = false;
+        _addr_armed = true;
+        _feed = words.data();
+        _feed_left = (count + PADDING) / 4;
+        spi.clear();
+    }
+
+    // Run until the null trigger flags completion; false if it never does
+    bool run() {
+        for (int step = 0; step < 10000000; step++) {
+            _sm.clock();
+            if (_feed_left && _sm.txf.size() < FIFO_DEPTH) {
+                _sm.txf.push_back(*_feed++);
+                _feed_left--;
+            }
+            if (_addr_armed && !_sm.rxf.empty()) {
+                uint32_t addr = _sm.rxf.front();
+                _sm.rxf.pop_front();
+                _addr_armed = false;
+                if (addr == 0) {
+                    _irq = true;        // Null trigger: data doesn't run
+                    return true;
+                }
+                if (addr < TABLE_ADDR || addr + 2 > TABLE_ADDR + sizeof(_table)) {
+                    printf("data channel read from %08X, outside the palette\n", addr);
+                    return false;
+                }
+                spi.push_back(_table[addr - TABLE_ADDR]);
+                spi.push_back(_table[addr - TABLE_ADDR + 1]);
+                _addr_armed = true;     // Chains back to addr
+            }
+        }
+        return false;
+    }
+
+    // PaletteDma::finish() aborts the feed channel
+    void finish() { _feed_left = 0; }
+
+    std::vector<uint8_t> spi;
+
+private:
+    // OSR shifting right with autopull at 32 bits, ISR shifting left with
+    // autopush at 32 bits
+    static PioConfig config() {
+        PioConfig c;
+        c.out_shift_right = true;
+        c.autopull = true;
+        c.autopush = true;
+        c.rx_depth = FIFO_DEPTH;
+        return c;
+    }
+
+    PioStateMachine _sm;
+    uint8_t _table[8];
+    bool _irq = false;
+    bool _addr_armed = false;
+    const uint32_t* _feed = nullptr;
+    size_t _feed_left = 0;
+};
+
+static uint32_t rng = 2024;
+static uint32_t next() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Frames of random shades through one chain; true if all came out right
+static bool runFrames(bool empty_osr, bool report) {
+    static const size_t counts[] = {160 * 144, 1001, 3, 192 * 173, 4};
+    Chain chain;
+    chain.init();
+    for (size_t f = 0; f < sizeof(counts) / sizeof(counts[0]); f++) {
+        size_t count = counts[f];
+        uint16_t palette[4];
+        for (int i = 0; i < 4; i++) palette[i] = (uint16_t)next();
+        chain.setPalette(palette);
+
+        // Word-aligned index buffer with the zero end marker after the frame
+        std::vector<uint32_t> words((count + PADDING + 3) / 4);
+        uint8_t* bytes = (uint8_t*)words.data();
+        std::vector<uint8_t> expected;
+        for (size_t i = 0; i < count; i++) {
+            uint8_t shade = next() & 3;
+            bytes[i] = INDEX_MARK | shade;
+            expected.push_back(palette[shade] >> 8);
+            expected.push_back(palette[shade] & 0xFF);
+        }
+        for (size_t i = 0; i < PADDING; i++) bytes[count + i] = 0;
+
+        chain.start(words, count, empty_osr);
+        bool stopped = chain.run();
+        chain.finish();
+        if (!stopped || chain.spi != expected) {
+            if (report) {
+                printf("frame %zu (%zu pixels): %s, %zu of %zu bytes sent\n", f, count,
+                       stopped ? "wrong pixels" : "chain never stopped", chain.spi.size(), expected.size());
+            }
+            return false;
+        }
+        if (report) printf("frame %zu: %zu pixels expanded, chain stopped on the end marker\n", f, count);
+    }
+    return true;
+}
+
+int main() {
+    bool ok = runFrames(true, true);
+    if (runFrames(false, false)) {
+        printf("a start that leaves the restarted OSR full should send nothing, but didn't fail\n");
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+// Host interpreter of one PIO state machine, shared by the models in this
+// directory (lcd_8080_model, palette_dma_model). It runs assembled programs
+// as pioasm emits them, one instruction per clock, with side-set, delays,
+// both shift directions, autopull and autopush. Pins are values rather
+// than GPIOs: the side-set, set and out pins each read back as the last
+// value written to them. Anything a program needs that isn't modelled
+// (WAIT, IRQ, pin inputs, exec destinations) stops the model.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+
+// The state machine configuration a program is initialized with
+struct PioConfig {
+    uint8_t sideset_bits = 0;       // Side-set pins (no enable bit)
+    uint8_t out_count = 32;         // Out pins
+    uint8_t set_count = 5;          // Set pins
+    bool out_shift_right = false;
+    bool autopull = false;
+    uint8_t pull_threshold = 32;
+    bool in_shift_right = false;
+    bool autopush = false;
+    uint8_t push_threshold = 32;
+    size_t rx_depth = 4;            // A full RX FIFO stalls pushes
+};
+
+class PioStateMachine {
+public:
+    // The TX FIFO isn't bounded: models load a whole stream into it
+    std::deque<uint32_t> txf;
+    std::deque<uint32_t> rxf;
+    bool enabled = true;
+
+    PioStateMachine(const uint16_t* program, uint8_t wrap_target, uint8_t wrap, const PioConfig& config) :
+        _program(program), _wrap_target(wrap_target), _wrap(wrap), _config(config) {}
+
+    // Pin levels before the first instruction, as pio_sm_set_pins sets them
+    void setPins(uint32_t sideset, uint32_t set, uint32_t out) {
+        _sideset_pins = sideset;
+        _set_pins = set;
+        _out_pins = out;
+    }
+
+    // As pio_sm_restart: shift counters and ISR cleared, delay dropped. An
+    // OSR shift count of zero means the OSR is full.
+    void restart() {
+        _isr = 0;
+        _isr_count = 0;
+        _osr_count = 0;
+        _delay = 0;
+    }
+
+    void clearFifos() {
+        txf.clear();
+        rxf.clear();
+    }
+
+    // As pio_sm_exec: run one instruction now; the model fails if it stalls
+    void exec(uint16_t instr) {
+        if (!execute(instr, true)) fail("executed instruction stalled");
+    }
+
+    // One state machine clock; false if the instruction stalled
+    bool clock() {
+        if (!enabled) return false;
+        if (_delay > 0) {
+            _delay--;
+            return true;
+        }
+        return execute(_program[_pc], false);
+    }
+
+    uint32_t sidesetPins() const { return _sideset_pins; }
+    uint32_t setPins() const { return _set_pins; }
+    uint32_t outPins() const { return _out_pins; }
+    uint8_t pc() const { return _pc; }
+
+private:
+    const uint16_t* _program;
+    uint8_t _wrap_target, _wrap;
+    PioConfig _config;
+    uint8_t _pc = 0;
+    uint8_t _delay = 0;
+    uint32_t _x = 0, _y = 0;
+    uint32_t _isr = 0, _osr = 0;
+    uint8_t _isr_count = 0, _osr_count = 32;
+    uint32_t _sideset_pins = 0, _set_pins = 0, _out_pins = 0;
+
+    static uint32_t mask(uint8_t bits) { return (bits >= 32) ? 0xFFFFFFFFu : (1u << bits) - 1; }
+
+    static uint32_t reverse(uint32_t v) {
+        uint32_t r = 0;
+        for (int i = 0; i < 32; i++) r |= ((v >> i) & 1) << (31 - i);
+        return r;
+    }
+
+    void pull() {
+        _osr = txf.front();
+        txf.pop_front();
+        _osr_count = 0;
+    }
+
+    // Shift bits of the OSR out in the configured direction
+    uint32_t shiftOut(uint8_t bits) {
+        uint32_t value;
+        if (_config.out_shift_right) {
+            value = _osr & mask(bits);
+            _osr = (bits == 32) ? 0 : _osr >> bits;
+        } else {
+            value = (bits == 32) ? _osr : _osr >> (32 - bits);
+            _osr = (bits == 32) ? 0 : _osr << bits;
+        }
+        _osr_count = (_osr_count + bits > 32) ? 32 : _osr_count + bits;
+        return value;
+    }
+
+    void shiftIn(uint32_t value, uint8_t bits) {
+        value &= mask(bits);
+        if (bits == 32) {
+            _isr = value;
+        } else if (_config.in_shift_right) {
+            _isr = (_isr >> bits) | (value << (32 - bits));
+        } else {
+            _isr = (_isr << bits) | value;
+        }
+        _isr_count = (_isr_count + bits > 32) ? 32 : _isr_count + bits;
+    }
+
+    // Returns false if the instruction stalled. forced: executed through
+    // exec(), which only moves the PC when the instruction jumps.
+    bool execute(uint16_t instr, bool forced) {
+        uint8_t op = instr >> 13;
+        uint8_t arg1 = (instr >> 5) & 7;
+        uint8_t arg2 = instr & 0x1F;
+        uint8_t bits = arg2 ? arg2 : 32;
+        uint8_t delay_field = (instr >> 8) & 0x1F;
+        uint8_t delay_bits = 5 - _config.sideset_bits;
+        uint8_t next = (_pc == _wrap) ? _wrap_target : _pc + 1;
+        bool jumped = false;
+
+        // Side-set applies even while the instruction stalls
+        if (_config.sideset_bits) {
+            _sideset_pins = delay_field >> delay_bits;
+        }
+
+        switch (op) {
+            case 0: {  // JMP
+                bool taken = false;
+                switch (arg1) {
+                    case 0: taken = true; break;
+                    case 1: taken = _x == 0; break;
+                    case 2: taken = _x != 0; _x--; break;
+                    case 3: taken = _y == 0; break;
+                    case 4: taken = _y != 0; _y--; break;
+                    case 5: taken = _x != _y; break;
+                    case 7: taken = _osr_count < _config.pull_threshold; break;   // !OSRE
+                    default: fail("unsupported jmp condition");
+                }
+                if (taken) {
+                    next = arg2;
+                    jumped = true;
+                }
+                break;
+            }
+            case 2: {  // IN
+                if (_config.autopush && _isr_count + bits >= _config.push_threshold &&
+                    rxf.size() >= _config.rx_depth) {
+                    return false;
+                }
+                uint32_t value;
+                switch (arg1) {
+                    case 1: value = _x; break;
+                    case 2: value = _y; break;
+                    case 3: value = 0; break;
+                    case 6: value = _isr; break;
+                    case 7: value = _osr; break;
+                    default: fail("unsupported in source"); return false;
+                }
+                shiftIn(value, bits);
+                if (_config.autopush && _isr_count >= _config.push_threshold) {
+                    rxf.push_back(_isr);
+                    _isr = 0;
+                    _isr_count = 0;
+                }
+                break;
+            }
+            case 3: {  // OUT
+                if (_config.autopull && _osr_count >= _config.pull_threshold) {
+                    if (txf.empty()) return false;
+                    pull();
+                }
+                uint32_t value = shiftOut(bits);
+                switch (arg1) {
+                    case 0: _out_pins = value & mask(_config.out_count); break;
+                    case 1: _x = value; break;
+                    case 2: _y = value; break;
+                    case 3: break;
+                    case 5: next = value & 0x1F; jumped = true; break;
+                    case 6: _isr = value; _isr_count = bits; break;
+                    default: fail("unsupported out destination");
+                }
+                break;
+            }
+            case 4: {  // PUSH / PULL
+                bool if_flag = instr & 0x40;
+                bool block = instr & 0x20;
+                if (instr & 0x80) {
+                    if (if_flag && _osr_count < _config.pull_threshold) break;   // IfEmpty
+                    if (txf.empty()) {
+                        if (block) return false;
+                        _osr = _x;      // Non-blocking pull of an empty FIFO
+                        _osr_count = 0;
+                    } else {
+                        pull();
+                    }
+                } else {
+                    if (if_flag && _isr_count < _config.push_threshold) break;  // IfFull
+                    if (rxf.size() >= _config.rx_depth) {
+                        if (block) return false;
+                    } else {
+                        rxf.push_back(_isr);
+                    }
+                    _isr = 0;
+                    _isr_count = 0;
+                }
+                break;
+            }
+            case 5: {  // MOV
+                uint32_t src;
+                switch (instr & 7) {
+                    case 1: src = _x; break;
+                    case 2: src = _y; break;
+                    case 3: src = 0; break;
+                    case 6: src = _isr; break;
+                    case 7: src = _osr; break;
+                    default: fail("unsupported mov source"); return false;
+                }
+                switch ((instr >> 3) & 3) {
+                    case 0: break;
+                    case 1: src = ~src; break;
+                    case 2: src = reverse(src); break;
+                    default: fail("unsupported mov operation");
+                }
+                switch (arg1) {
+                    case 1: _x = src; break;
+                    case 2: _y = src; break;
+                    case 5: next = src & 0x1F; jumped = true; break;
+                    case 6: _isr = src; _isr_count = 0; break;
+                    case 7: _osr = src; _osr_count = 0; break;
+                    default: fail("unsupported mov destination");
+                }
+                break;
+            }
+            case 7:  // SET
+                switch (arg1) {
+                    case 0: _set_pins = arg2 & mask(_config.set_count); break;
+                    case 1: _x = arg2; break;
+                    case 2: _y = arg2; break;
+                    default: fail("unsupported set destination");
+                }
+                break;
+            default:
+                fail("unsupported instruction");
+        }
+
+        if (!forced || jumped) _pc = next;
+        _delay = delay_field & mask(delay_bits);
+        return true;
+    }
+
+    static void fail(const char* what) {
+        printf("PIO model: %s\n", what);
+        exit(1);
+    }
+};
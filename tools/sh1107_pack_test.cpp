@@ -0,0 +1,158 @@
+// Host check of the SH1107 page build (src/displays/sh1107/sh1107_pack.cpp).
+// Compares the 8x8 transpose against a bit-by-bit one, and buildPage()
+// against the per-pixel loop drawRegion() used before it, over random
+// regions (clipped at every edge, odd widths, strides wider than the
+// region) of colour and dithered black and white frames. Then times both
+// page builds on the main.cpp layout (128x115 at y 6, 16 pages).
+//
+//   g++ -std=c++17 -O2 -Iinclude tools/sh1107_pack_test.cpp src/displays/sh1107/sh1107_pack.cpp -o sh1107_pack_test
+//   ./sh1107_pack_test
+
+#include "displays/sh1107/sh1107_pack.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace sh1107;
+
+static const int DISPLAY_W = 128;
+static const int DISPLAY_H = 128;
+
+// The loop drawRegion() had for one page, kept as the reference
+static void referencePage(const displays::ImageRegion& region, int page, int draw_x, int draw_w, uint8_t* out) {
+    const int x = region.x, y = region.y, w = region.w, h = region.h;
+    memset(out, 0, draw_w);
+    for (int col = 0; col < draw_w; ++col) {
+        uint8_t byte = 0;
+        for (int bit = 0; bit < 8; ++bit) {
+            int screen_y = page * 8 + bit;
+            int src_y = screen_y - y;
+            int src_x = (draw_x + col) - x;
+            if (src_x < 0 || src_x >= w || src_y < 0 || src_y >= h) continue;
+            uint16_t pix = region.pixels[src_y * region.stride + src_x];
+            uint8_t r = (pix >> 8) & 0xF8;
+            uint8_t g = (pix >> 3) & 0xFC;
+            uint8_t b = (pix << 3) & 0xF8;
+            uint16_t lum = (r + (g << 1) + b) >> 2;
+            if (lum > 128) byte |= (1 << bit);
+        }
+        out[col] = byte;
+    }
+}
+
+static uint32_t rng = 12345;
+static uint32_t next() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static bool checkTranspose() {
+    for (int i = 0; i < 100000; i++) {
+        uint64_t x = ((uint64_t)next() << 32) | next();
+        uint64_t expected = 0;
+        for (int r = 0; r < 8; r++) {
+            for (int c = 0; c < 8; c++) {
+                if (x >> (8 * r + c) & 1) expected |= 1ull << (8 * c + r);
+            }
+        }
+        if (transpose8x8(x) != expected) {
+            printf("transpose8x8(%016llX) = %016llX, expected %016llX\n", (unsigned long long)x,
+                   (unsigned long long)transpose8x8(x), (unsigned long long)expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Clip as drawRegion() does and compare every page it would send
+static bool checkRegion(const displays::ImageRegion& region) {
+    const int x = region.x, y = region.y, w = region.w, h = region.h;
+    if (x >= DISPLAY_W || y >= DISPLAY_H || x + w <= 0 || y + h <= 0) return true;
+    int draw_x = (x < 0) ? 0 : x;
+    int draw_y = (y < 0) ? 0 : y;
+    int draw_w = ((x + w) > DISPLAY_W) ? (DISPLAY_W - draw_x) : (w - (draw_x - x));
+    int draw_h = ((y + h) > DISPLAY_H) ? (DISPLAY_H - draw_y) : (h - (draw_y - y));
+
+    uint8_t expected[MAX_PAGE_WIDTH], got[MAX_PAGE_WIDTH];
+    for (int page = draw_y / 8; page <= (draw_y + draw_h - 1) / 8; ++page) {
+        referencePage(region, page, draw_x, draw_w, expected);
+        buildPage(region, page, draw_x, draw_w, got);
+        if (memcmp(expected, got, draw_w) != 0) {
+            printf("region %dx%d at (%d, %d), stride %d: page %d differs\n", w, h, x, y, region.stride, page);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool checkPages() {
+    std::vector<uint16_t> image(200 * 200);
+    for (int i = 0; i < 20000; i++) {
+        bool bw = i & 1;    // As ditherFrame() leaves it, or any colour
+        for (uint16_t& p : image) {
+            p = bw ? ((next() & 1) ? 0xFFFF : 0x0000) : (uint16_t)next();
+        }
+        displays::ImageRegion region;
+        region.w = 1 + next() % 160;
+        region.h = 1 + next() % 160;
+        region.stride = region.w + next() % 40;
+        region.x = (int16_t)(next() % 200) - 40;
+        region.y = (int16_t)(next() % 200) - 40;
+        region.pixels = image.data();
+        if (!checkRegion(region)) return false;
+    }
+    return true;
+}
+
+template <typename Build>
+static double nsPerPage(Build build, const displays::ImageRegion& region, int pages, int frames) {
+    uint8_t out[MAX_PAGE_WIDTH];
+    volatile uint8_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; f++) {
+        for (int page = region.y / 8; page < region.y / 8 + pages; page++) {
+            build(region, page, region.x, region.w, out);
+            sink = sink + out[f % region.w];
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ((double)frames * pages);
+}
+
+static void benchmark() {
+    const int w = 128, h = 115, y = 6, frames = 20000;
+    const int pages = (y + h - 1) / 8 - y / 8 + 1;
+    std::vector<uint16_t> frame(w * h);
+    for (uint16_t& p : frame) p = (next() & 1) ? 0xFFFF : 0x0000;
+    const displays::ImageRegion region = {0, y, w, h, frame.data(), (uint16_t)w};
+
+    double before = nsPerPage(referencePage, region, pages, frames);
+    double after = nsPerPage(buildPage, region, pages, frames);
+    printf("page build, %dx%d in %d pages: per-pixel loop %.0f ns/page, transpose %.0f ns/page (%.1fx)\n",
+           w, h, pages, before, after, before / after);
+
+    std::vector<uint64_t> blocks(4096);
+    for (uint64_t& b : blocks) b = ((uint64_t)next() << 32) | next();
+    uint64_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < 2000; n++) {
+        for (uint64_t b : blocks) sum += transpose8x8(b + n);
+    }
+    auto end = std::chrono::steady_clock::now();
+    printf("transpose8x8: %.2f ns/block (%llX)\n",
+           std::chrono::duration<double, std::nano>(end - start).count() / (2000.0 * blocks.size()),
+           (unsigned long long)(sum & 0xF));
+}
+
+int main() {
+    if (!checkTranspose() || !checkPages()) {
+        return 1;
+    }
+    printf("transpose and page build match the reference\n");
+    benchmark();
+    return 0;
+}
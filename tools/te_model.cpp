@@ -0,0 +1,123 @@
+// Host model of the TE band scheduler (src/displays/common/scan_schedule.cpp).
+// Plans frames for the supported panels and a sweep of random geometries,
+// then replays every gate line of every band against the panel's read of
+// that line in the current and the next refresh. Fails if a plan reported
+// as tear-free lets the write overtake the read or run into the next
+// refresh, or if a plan reported as tearing replays clean.
+//
+//   g++ -std=c++17 -Iinclude tools/te_model.cpp src/displays/common/scan_schedule.cpp -o te_model
+//   ./te_model
+
+#include "displays/common/scan_schedule.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace displays;
+
+static const size_t MAX_BANDS = 8;  // As in TePresenter
+
+// Replay the bands line by line; returns the number of lines that tear
+static int replay(const ScanTiming& scan, const ScanBand* bands, size_t count,
+                  int64_t write_line_ns, BandOrder order) {
+    const int64_t line = scan.lineNs();
+    int tears = 0;
+    int64_t bus_free = 0;
+    for (size_t i = 0; i < count; i++) {
+        const ScanBand& band = bands[i];
+        int64_t start = (band.start_ns > bus_free) ? band.start_ns : bus_free;
+        int64_t n = band.last - band.first;
+        for (int64_t l = band.first; l < band.last; l++) {
+            int64_t write_begin, write_end;
+            if (order == BAND_SEQUENTIAL) {
+                write_begin = start + (l - band.first) * write_line_ns;
+                write_end = write_begin + write_line_ns;
+            } else {
+                write_begin = start;
+                write_end = start + n * write_line_ns;
+            }
+            int64_t read_end = (scan.blank_lines + l + 1) * line;
+            int64_t next_read = scan.period_ns + (scan.blank_lines + l) * line;
+            if (write_begin < read_end || write_end > next_read) {
+                tears++;
+            }
+        }
+        bus_free = start + n * write_line_ns;
+    }
+    return tears;
+}
+
+static bool check(const char* name, const ScanTiming& scan, uint16_t first, uint16_t last,
+                  uint32_t write_line_ns, BandOrder order, bool verbose) {
+    ScanBand bands[MAX_BANDS];
+    size_t count = 0;
+    bool tear_free = planScanBands(scan, first, last, write_line_ns, order, bands, MAX_BANDS, count);
+    int tears = replay(scan, bands, count, write_line_ns, order);
+
+    bool ok = count > 0 && count <= MAX_BANDS && (tear_free == (tears == 0));
+    for (size_t i = 1; ok && i < count; i++) {
+        ok = bands[i].first == bands[i - 1].last && bands[i].start_ns >= bands[i - 1].start_ns;
+    }
+    ok = ok && bands[0].first == first && bands[count - 1].last == last;
+
+    if (verbose || !ok) {
+        int64_t end = bands[count - 1].start_ns + (int64_t)(bands[count - 1].last - bands[count - 1].first) * write_line_ns;
+        printf("%-34s %-10s %2zu bands, %5.2f ms to %5.2f ms of %5.2f ms: %s%s\n",
+               name, order == BAND_SEQUENTIAL ? "sequential" : "block", count,
+               bands[0].start_ns / 1e6, end / 1e6, scan.period_ns / 1e6,
+               tear_free ? "tear-free" : "tears", ok ? "" : "  <-- MODEL MISMATCH");
+    }
+    return ok;
+}
+
+int main() {
+    struct Case {
+        const char* name;
+        uint16_t lines, blank;
+        double refresh_hz;
+        uint16_t first, last;           // Gate lines of the Game Boy image
+        uint32_t pixels_per_line;
+        double bus_mhz;
+        BandOrder order;
+    };
+    // main.cpp setups: ILI9341 at ROTATION_270 is MADCTL_MV (strips),
+    // ST7789 240x240 and ST7796 at 180 run rows along the scan
+    const Case cases[] = {
+        {"ILI9341 256x230, 40 MHz, 79 Hz",   320, 4,  79.0,  46, 302, 230, 40.0, BAND_BLOCK},
+        {"ILI9341 256x230, 40 MHz, 59.7 Hz", 320, 4,  59.73, 46, 302, 230, 40.0, BAND_BLOCK},
+        {"ILI9341 256x230, 62.5 MHz, 70 Hz", 320, 4,  70.0,  46, 302, 230, 62.5, BAND_BLOCK},
+        {"ST7789 240x216, 40 MHz, 60 Hz",    320, 24, 60.0,  12, 228, 240, 40.0, BAND_SEQUENTIAL},
+        {"ST7789 240x216, 40 MHz, 60 Hz",    320, 24, 60.0,  12, 228, 240, 40.0, BAND_BLOCK},
+        {"ST7796 320x288, 62.5 MHz, 60 Hz",  480, 4,  60.0, 192, 480, 320, 62.5, BAND_BLOCK},
+        {"ST7796 320x288, 62.5 MHz, 60 Hz",  480, 4,  60.0,   0, 288, 320, 62.5, BAND_SEQUENTIAL},
+    };
+
+    bool ok = true;
+    for (const Case& c : cases) {
+        ScanTiming scan;
+        scan.period_ns = (uint32_t)(1e9 / c.refresh_hz);
+        scan.lines = c.lines;
+        scan.blank_lines = c.blank;
+        uint32_t write_line_ns = (uint32_t)(c.pixels_per_line * 16 * 1000 / c.bus_mhz);
+        ok &= check(c.name, scan, c.first, c.last, write_line_ns, c.order, true);
+    }
+
+    // Random geometries, both faster and slower than the scan
+    srand(1);
+    int runs = 0;
+    for (; runs < 200000; runs++) {
+        ScanTiming scan;
+        scan.lines = 16 + rand() % 480;
+        scan.blank_lines = rand() % 32;
+        scan.period_ns = 8000000 + rand() % 16000000;
+        uint16_t first = rand() % scan.lines;
+        uint16_t last = first + 1 + rand() % (scan.lines - first);
+        uint32_t write_line_ns = 1000 + rand() % 120000;
+        BandOrder order = (rand() & 1) ? BAND_SEQUENTIAL : BAND_BLOCK;
+        if (!check("random", scan, first, last, write_line_ns, order, false)) {
+            ok = false;
+            break;
+        }
+    }
+    printf("%d random plans %s\n", runs, ok ? "agree with the replay" : "checked before a mismatch");
+    return ok ? 0 : 1;
+}